@@ -0,0 +1,157 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// analysis_store.cpp, version 1.8
+
+#include "analysis_store.h"
+#include "misc.h"
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+namespace
+{
+	constexpr char AS_MAGIC[8] = { 'C', 'H', 'K', 'R', 'S', 'A', 'S', '1' };
+	struct StoreHeader
+	{
+		char magic[8];
+		uint64_t slot_count;
+	};
+}
+
+AnalysisStore::AnalysisStore(void) noexcept
+	: slots(nullptr), slot_count(0)
+{}
+
+AnalysisStore::~AnalysisStore(void) noexcept = default;
+
+void AnalysisStore::open(const std::string& file_name)
+{
+	close();
+	file.open(file_name, true);
+	StoreHeader header;
+	if (file.size() < sizeof(header))
+	{
+		file.close();
+		throw(checkers_error("Analysis store has wrong size"));
+	}
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (std::memcmp(header.magic, AS_MAGIC, sizeof(AS_MAGIC)) != 0 || header.slot_count == 0
+		|| file.size() != sizeof(header) + header.slot_count * sizeof(Slot))
+	{
+		file.close();
+		throw(checkers_error("Analysis store has wrong format"));
+	}
+	slots = reinterpret_cast<Slot*>(file.data() + sizeof(header));
+	slot_count = size_t(header.slot_count);
+}
+
+void AnalysisStore::create(const std::string& file_name, size_t count)
+{
+	close();
+	if (count == 0)
+		throw(checkers_error("Analysis store should have at least one slot"));
+	std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+	if (!out)
+		throw(checkers_error("Unable to create analysis store file " + file_name));
+	StoreHeader header;
+	std::memcpy(header.magic, AS_MAGIC, sizeof(AS_MAGIC));
+	header.slot_count = count;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	const std::vector<Slot> chunk(std::min<size_t>(count, 1 << 16), Slot{ 0, 0 });
+	for (size_t written = 0; written < count; written += chunk.size())
+		out.write(reinterpret_cast<const char*>(chunk.data()),
+			std::min(chunk.size(), count - written) * sizeof(Slot));
+	out.close();
+	if (!out)
+		throw(checkers_error("Unable to write analysis store file " + file_name));
+	open(file_name);
+}
+
+void AnalysisStore::close(void) noexcept
+{
+	file.close();
+	slots = nullptr;
+	slot_count = 0;
+}
+
+bool AnalysisStore::probe(uint64_t key, StoreResult& result) const noexcept
+{
+	if (!is_open())
+		return false;
+	const size_t first = size_t(key % slot_count);
+	for (int i = 0; i < PROBE_COUNT; ++i)
+	{
+		const Slot& slot = slots[(first + i) % slot_count];
+		// Read the slot once, because other processes may be writing it right now
+		const uint64_t check = slot.check, data = slot.data;
+		if (slot_key(check, data) == key)
+		{
+			result = unpack(data);
+			return true;
+		}
+	}
+	return false;
+}
+
+void AnalysisStore::store(uint64_t key, const StoreResult& result) noexcept
+{
+	if (!is_open() || result.depth <= 0)
+		return;
+	const size_t first = size_t(key % slot_count);
+	Slot* replaced = nullptr;
+	int replaced_depth = result.depth; // Only shallower results are replaced
+	for (int i = 0; i < PROBE_COUNT; ++i)
+	{
+		Slot& slot = slots[(first + i) % slot_count];
+		const uint64_t check = slot.check, data = slot.data, slot_k = slot_key(check, data);
+		const int depth = unpack(data).depth;
+		if (slot_k == key)
+		{
+			// Keep the deeper result
+			replaced = (depth <= result.depth ? &slot : nullptr);
+			break;
+		}
+		// Prefer the first empty slot, then the shallowest one
+		if (slot_k == 0 && replaced_depth >= 0)
+			replaced = &slot, replaced_depth = -1;
+		else if (depth < replaced_depth)
+			replaced = &slot, replaced_depth = depth;
+	}
+	if (replaced != nullptr)
+	{
+		const uint64_t data = pack(result);
+		replaced->data = data;
+		replaced->check = key ^ data;
+	}
+}
+
+size_t AnalysisStore::merge(const AnalysisStore& other) noexcept
+{
+	size_t merged = 0;
+	for (size_t i = 0; i < other.slot_count; ++i)
+	{
+		const uint64_t check = other.slots[i].check, data = other.slots[i].data, key = slot_key(check, data);
+		if (key != 0)
+			store(key, unpack(data)), ++merged;
+	}
+	return merged;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// analysis_store.h, version 1.8
+
+#pragma once
+#ifndef _ANALYSIS_STORE_H
+#define _ANALYSIS_STORE_H
+#include <string>
+#include "move.h"
+#include "mapped_file.h"
+
+// Result of a finished search of some position
+struct StoreResult
+{
+	int16_t score; // Exact score for side to move (in transposition table form, see Checkers::value_to_tt)
+	int8_t depth; // Depth of the search
+	PseudoMove best_move; // Best move found by the search
+};
+
+// Persistent on-disk store of exact search results keyed by full position hash, which is memory-mapped
+// and shared by all processes using the same file. Slots hold key xor'ed with data, so entries which are
+// torn by concurrent writers of different processes are detected and ignored instead of being trusted
+class AnalysisStore
+{
+public:
+	static constexpr int PROBE_COUNT = 4; // Count of consecutive slots where an entry can be placed
+	static constexpr size_t DEFAULT_SLOT_COUNT = size_t(1) << 22; // Default slot count (64 MB)
+	// Constructor
+	AnalysisStore(void) noexcept;
+	// Destructor
+	~AnalysisStore(void) noexcept;
+	// Public member functions
+	inline bool is_open(void) const noexcept;
+	inline size_t size(void) const noexcept; // Count of slots
+	void open(const std::string&); // Maps existing store file for reading and writing
+	void create(const std::string&, size_t = DEFAULT_SLOT_COUNT); // Creates empty store file with given slot count and opens it
+	void close(void) noexcept; // Unmaps the store
+	// Finds result for position with given full hash. Returns false if there is no such
+	bool probe(uint64_t, StoreResult&) const noexcept;
+	// Records result for position with given full hash if it is deeper than already stored one
+	void store(uint64_t, const StoreResult&) noexcept;
+	// Records all results from given store (deeper ones win). Returns count of merged entries
+	size_t merge(const AnalysisStore&) noexcept;
+private:
+	struct Slot
+	{
+		uint64_t check; // Key xor data (0 for empty slot)
+		uint64_t data; // Packed StoreResult
+	};
+	static inline uint64_t pack(const StoreResult&) noexcept;
+	static inline StoreResult unpack(uint64_t) noexcept;
+	// Returns key of slot with given contents or 0 if it is empty
+	static inline uint64_t slot_key(uint64_t, uint64_t) noexcept;
+	MappedFile file;
+	Slot* slots; // Slots which start right after the header in the mapped file
+	size_t slot_count;
+};
+
+inline bool AnalysisStore::is_open(void) const noexcept
+{
+	return slots != nullptr;
+}
+
+inline size_t AnalysisStore::size(void) const noexcept
+{
+	return slot_count;
+}
+
+inline uint64_t AnalysisStore::pack(const StoreResult& result) noexcept
+{
+	return uint64_t(uint16_t(result.score)) | uint64_t(uint8_t(result.depth)) << 16
+		| uint64_t(pos_idx(result.best_move.from)) << 24 | uint64_t(pos_idx(result.best_move.to)) << 32;
+}
+
+inline StoreResult AnalysisStore::unpack(uint64_t data) noexcept
+{
+	const int from = (data >> 24) & 0xff, to = (data >> 32) & 0xff;
+	return { int16_t(data & 0xffff), int8_t((data >> 16) & 0xff),
+		{ Position(from >> 3, from & 7), Position(to >> 3, to & 7) } };
+}
+
+inline uint64_t AnalysisStore::slot_key(uint64_t check, uint64_t data) noexcept
+{
+	// Stored results always have positive depth, so zeroed (empty) slots are never valid
+	return ((data >> 16) & 0xff) == 0 ? 0 : check ^ data;
+}
+
+#endif
\ No newline at end of file
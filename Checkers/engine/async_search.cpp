@@ -0,0 +1,78 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// async_search.cpp, version 1.8
+
+#include "async_search.h"
+
+AsyncSearch::AsyncSearch(Checkers& eng) noexcept
+	: engine(eng), running(false)
+{}
+
+AsyncSearch::~AsyncSearch(void) noexcept
+{
+	stop();
+	wait();
+}
+
+void AsyncSearch::start(std::function<void(const SearchResult&)> on_finish)
+{
+	wait();
+	engine.reset_stop();
+	running = true;
+	worker = std::thread([this, on_finish]() {
+		SearchResult result;
+		result.depth = engine.get_computer_move(result.move, result.score);
+		if (on_finish)
+			on_finish(result);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+		}
+		finish_cv.notify_all();
+	});
+}
+
+void AsyncSearch::stop(void) noexcept
+{
+	engine.request_stop();
+}
+
+void AsyncSearch::stop_after(float time)
+{
+	if (timer.joinable())
+		timer.join();
+	const auto deadline = std::chrono::steady_clock::now()
+		+ std::chrono::microseconds(static_cast<int64_t>(time * 1000));
+	timer = std::thread([this, deadline]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!finish_cv.wait_until(lock, deadline, [this]() { return !running; }))
+			engine.request_stop();
+	});
+}
+
+void AsyncSearch::wait(void)
+{
+	if (worker.joinable())
+		worker.join();
+	if (timer.joinable())
+		timer.join();
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// async_search.h, version 1.8
+
+#pragma once
+#ifndef _ASYNC_SEARCH_H
+#define _ASYNC_SEARCH_H
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "checkers.h"
+
+// Result of finished search
+struct SearchResult
+{
+	Move move; // Best move (empty if the game has ended)
+	int score; // Score for side to move
+	int8_t depth; // Depth of the last finished iteration
+};
+
+// Runs engine's search in a background thread, so that the caller stays responsive (e.g. reads commands).
+// The engine shouldn't be used otherwise until the search is finished
+class AsyncSearch
+{
+public:
+	// Constructor
+	AsyncSearch(Checkers&) noexcept;
+	// Destructor. Stops the search and waits for it
+	~AsyncSearch(void) noexcept;
+	// Public member functions
+	// Starts search of engine's current position. Given function receives the result in the search thread
+	// (so it shouldn't call wait)
+	void start(std::function<void(const SearchResult&)>);
+	void stop(void) noexcept; // Requests stop of the search (its result is still reported)
+	void stop_after(float); // Requests stop after given time (ms) from now (it is intended to be called once per search)
+	void wait(void); // Waits until the search is finished and its result is reported
+	inline bool is_running(void) const noexcept;
+private:
+	Checkers& engine;
+	std::thread worker; // Thread which runs the search
+	std::thread timer; // Thread which stops the search at deadline
+	std::mutex mutex;
+	std::condition_variable finish_cv;
+	std::atomic<bool> running; // Whether the search is not finished yet
+};
+
+inline bool AsyncSearch::is_running(void) const noexcept
+{
+	return running;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,342 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// bitbase.cpp, version 1.8
+
+#include "bitbase.h"
+#include "misc.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+	// Version 2 bounds values of queens-only positions by the consecutive queen moves limit
+	constexpr char BB_MAGIC[8] = { 'C', 'H', 'K', 'R', 'S', 'B', 'B', '2' };
+	constexpr wdl WDL_UNKNOWN = WDL_NONE; // Value of not yet resolved position during generation
+	// Maximum ply count of queens-only game (consecutive queen moves of both players)
+	constexpr int QUEEN_PLY_LIMIT = 2 * Board::DRAW_CONSECUTIVE_QUEEN_MOVES;
+}
+
+// Board which is used for setting up and expanding positions during bitbase generation
+class BitbaseBuilder
+	: public Board
+{
+public:
+	BitbaseBuilder(Bitbase& bb, game_rules rule)
+		: Board(rule), bitbase(bb)
+	{}
+	// Decodes position with given index from table of given signature. Returns false if it is illegal
+	bool set_position(const int8_t(&)[4], uint64_t);
+	// Resolves current position (white to move) using values of its successors
+	wdl resolve(void);
+	// Resolves current queens-only position (white to move) using values and game lengths (in plies) of its
+	// resolved successors. Returns WDL_UNKNOWN if the game doesn't end within given ply count, otherwise writes its length
+	wdl resolve_within(const std::vector<std::vector<uint8_t>>&, int, int&);
+private:
+	Bitbase& bitbase;
+};
+
+Bitbase::Bitbase(void) noexcept
+	: rules(RULES_DEFAULT), max_pieces(0), loaded(false)
+{}
+
+Bitbase::~Bitbase(void) noexcept = default;
+
+void Bitbase::_build_layout(void)
+{
+	signatures.clear();
+	table_offset.assign(sig_idx(MAX_PIECES, MAX_PIECES, MAX_PIECES, MAX_PIECES) + 1, 0);
+	table_size.assign(table_offset.size(), 0);
+	uint64_t offset = 0;
+	// Order of tables is such that every position's successors are either in the tables of the same
+	// group (equal overall and simple piece counts) or in already generated ones (captures reduce overall
+	// count and promotions reduce simple piece count), which is important for generation
+	for (int8_t overall = 2; overall <= max_pieces; ++overall)
+		for (int8_t simple = 0; simple <= overall; ++simple)
+			for (int8_t ws = 0; ws <= simple; ++ws)
+				for (int8_t wq = 0; wq <= overall - simple; ++wq)
+				{
+					const int8_t bs = simple - ws, bq = overall - simple - wq;
+					if (ws + wq == 0 || bs + bq == 0)
+						continue;
+					const int idx = sig_idx(ws, wq, bs, bq);
+					signatures.push_back({ { ws, wq, bs, bq } });
+					table_offset[idx] = offset;
+					table_size[idx] = BB_BINOMIAL(SQUARE_COUNT, ws) * BB_BINOMIAL(SQUARE_COUNT, wq)
+						* BB_BINOMIAL(SQUARE_COUNT, bs) * BB_BINOMIAL(SQUARE_COUNT, bq);
+					offset += table_size[idx];
+				}
+	data.allocate((offset + 3) >> 2, true);
+}
+
+bool BitbaseBuilder::set_position(const int8_t(&count)[4], uint64_t idx)
+{
+	static constexpr piece_type group_type[4] = { WHITE_SIMPLE, WHITE_QUEEN, BLACK_SIMPLE, BLACK_QUEEN };
+	int squares[4][Bitbase::MAX_PIECES];
+	// Unrank squares of each group (the last group is the least significant in the index)
+	for (int group = 3; group >= 0; --group)
+	{
+		const uint64_t group_size = BB_BINOMIAL(Bitbase::SQUARE_COUNT, count[group]);
+		uint64_t rank = idx % group_size;
+		idx /= group_size;
+		for (int i = count[group]; i > 0; --i)
+		{
+			int sq = Bitbase::SQUARE_COUNT - 1;
+			while (BB_BINOMIAL(sq, i) > rank)
+				--sq;
+			squares[group][i - 1] = sq;
+			rank -= BB_BINOMIAL(sq, i);
+		}
+	}
+	_clear_board();
+	for (int group = 0; group < 4; ++group)
+		for (int i = 0; i < count[group]; ++i)
+		{
+			const int sq = squares[group][i], row = sq >> 2;
+			const Position pos(row, ((sq & 3) << 1) + (row & 1));
+			// Pieces can't share a square and simple pieces can't stay at their promotion row
+			if (board[pos.get_row()][pos.get_column()].get_type() != PT_EMPTY
+				|| (group == 0 && row == 7) || (group == 2 && row == 0))
+				return false;
+			_put_piece(pos, Piece(group_type[group]));
+		}
+	return true;
+}
+
+wdl BitbaseBuilder::resolve(void)
+{
+	MoveList moves;
+	get_all_moves<WHITE>(moves);
+	remove_equivalent_captures(moves);
+	bool all_win = true; // Whether all successors are won for the opponent (true if there are no moves)
+	for (int i = 0; i < moves.size(); ++i)
+	{
+		_do_move(moves[i].move);
+		const wdl child = (piece_count[BLACK_SIMPLE] + piece_count[BLACK_QUEEN] == 0 ?
+			WDL_LOSS : bitbase.probe(*this, BLACK));
+		_undo_move(moves[i].move);
+		if (child == WDL_LOSS)
+			return WDL_WIN;
+		if (child != WDL_WIN)
+			all_win = false;
+	}
+	return all_win ? WDL_LOSS : WDL_UNKNOWN;
+}
+
+wdl BitbaseBuilder::resolve_within(const std::vector<std::vector<uint8_t>>& plies, int limit, int& length)
+{
+	MoveList moves;
+	get_all_moves<WHITE>(moves);
+	remove_equivalent_captures(moves);
+	// The winner ends the game as soon as possible and the loser delays it as long as possible
+	int win_length = limit + 1, loss_length = 0;
+	bool all_win = true;
+	for (int i = 0; i < moves.size(); ++i)
+	{
+		_do_move(moves[i].move);
+		wdl child = WDL_LOSS;
+		int child_length = 0;
+		int sig;
+		uint64_t idx;
+		if (bitbase._locate(*this, BLACK, sig, idx)) // Otherwise all opponent pieces are captured
+		{
+			child = bitbase._get(bitbase.table_offset[sig] + idx);
+			child_length = plies[sig][idx];
+		}
+		_undo_move(moves[i].move);
+		if (child == WDL_WIN)
+			loss_length = std::max(loss_length, child_length + 1);
+		else
+		{
+			all_win = false;
+			if (child == WDL_LOSS)
+				win_length = std::min(win_length, child_length + 1);
+		}
+	}
+	if (win_length <= limit)
+		return length = win_length, WDL_WIN;
+	if (all_win && loss_length <= limit)
+		return length = loss_length, WDL_LOSS;
+	return WDL_UNKNOWN;
+}
+
+void Bitbase::generate(game_rules rule, int max_pcs, std::ostream* log)
+{
+	if (max_pcs < 2 || max_pcs > MAX_PIECES)
+		throw(checkers_error("Bitbase piece count should be in range [2; "
+			+ std::to_string(MAX_PIECES) + "]"));
+	rules = rule;
+	max_pieces = max_pcs;
+	_build_layout();
+	loaded = true; // Already generated tables are probed during generation of others
+	BitbaseBuilder builder(*this, rules);
+	std::vector<std::vector<uint8_t>> plies(table_offset.size()); // Game lengths of resolved queens-only positions
+	int longest = 0; // Maximum game length among them
+	for (size_t group_begin = 0, group_end; group_begin < signatures.size(); group_begin = group_end)
+	{
+		// Find group of tables which depend on each other
+		const auto group_key = [this](size_t i) {
+			const auto& cnt = signatures[i].count;
+			return std::make_pair(cnt[0] + cnt[1] + cnt[2] + cnt[3], cnt[0] + cnt[2]);
+		};
+		for (group_end = group_begin + 1; group_end < signatures.size()
+			&& group_key(group_end) == group_key(group_begin); ++group_end);
+		// Mark all legal positions as unknown (illegal ones stay draws and are never probed)
+		for (size_t t = group_begin; t < group_end; ++t)
+		{
+			const auto& cnt = signatures[t].count;
+			const int sig = sig_idx(cnt[0], cnt[1], cnt[2], cnt[3]);
+			for (uint64_t idx = 0; idx < table_size[sig]; ++idx)
+				if (builder.set_position(cnt, idx))
+					_set(table_offset[sig] + idx, WDL_UNKNOWN);
+		}
+		// Queens-only games end in a draw after the consecutive queen moves limit, so values of their positions
+		// are propagated ply by ply (each pass uses only results of previous ones to get exact game lengths)
+		if (group_key(group_begin).second == 0)
+		{
+			struct Resolved
+			{
+				int sig;
+				uint64_t idx;
+				wdl value;
+				uint8_t length;
+			};
+			std::vector<Resolved> resolved;
+			for (size_t t = group_begin; t < group_end; ++t)
+			{
+				const auto& cnt = signatures[t].count;
+				const int sig = sig_idx(cnt[0], cnt[1], cnt[2], cnt[3]);
+				plies[sig].assign(table_size[sig], 0);
+			}
+			for (int ply = 0; ply <= QUEEN_PLY_LIMIT; ++ply)
+			{
+				resolved.clear();
+				for (size_t t = group_begin; t < group_end; ++t)
+				{
+					const auto& cnt = signatures[t].count;
+					const int sig = sig_idx(cnt[0], cnt[1], cnt[2], cnt[3]);
+					for (uint64_t idx = 0; idx < table_size[sig]; ++idx)
+						if (_get(table_offset[sig] + idx) == WDL_UNKNOWN)
+						{
+							builder.set_position(cnt, idx);
+							int length;
+							const wdl value = builder.resolve_within(plies, ply, length);
+							if (value != WDL_UNKNOWN)
+								resolved.push_back({ sig, idx, value, uint8_t(length) });
+						}
+				}
+				for (const Resolved& res : resolved)
+				{
+					_set(table_offset[res.sig] + res.idx, res.value);
+					plies[res.sig][res.idx] = res.length;
+					longest = std::max(longest, int(res.length));
+				}
+				// Next passes can't resolve anything if neither this pass did nor there are longer games
+				if (resolved.empty() && ply > longest)
+					break;
+			}
+		}
+		else
+			// Propagate known values until nothing changes. Remaining unknown positions are draws
+			for (bool changed = true; changed; )
+			{
+				changed = false;
+				for (size_t t = group_begin; t < group_end; ++t)
+				{
+					const auto& cnt = signatures[t].count;
+					const int sig = sig_idx(cnt[0], cnt[1], cnt[2], cnt[3]);
+					for (uint64_t idx = 0; idx < table_size[sig]; ++idx)
+						if (_get(table_offset[sig] + idx) == WDL_UNKNOWN)
+						{
+							builder.set_position(cnt, idx);
+							const wdl value = builder.resolve();
+							if (value != WDL_UNKNOWN)
+								_set(table_offset[sig] + idx, value), changed = true;
+						}
+				}
+			}
+		for (size_t t = group_begin; t < group_end; ++t)
+		{
+			const auto& cnt = signatures[t].count;
+			const int sig = sig_idx(cnt[0], cnt[1], cnt[2], cnt[3]);
+			uint64_t stats[4] = {};
+			for (uint64_t idx = 0; idx < table_size[sig]; ++idx)
+			{
+				if (_get(table_offset[sig] + idx) == WDL_UNKNOWN)
+					_set(table_offset[sig] + idx, WDL_DRAW);
+				++stats[_get(table_offset[sig] + idx)];
+			}
+			if (log != nullptr)
+				*log << "WS " << int(cnt[0]) << " WQ " << int(cnt[1]) << " BS " << int(cnt[2])
+					<< " BQ " << int(cnt[3]) << ": " << stats[WDL_WIN] << " wins, " << stats[WDL_LOSS]
+					<< " losses, " << stats[WDL_DRAW] << " draws or illegal\n";
+		}
+	}
+}
+
+void Bitbase::load(const std::string& file_name)
+{
+	std::ifstream in(file_name, std::ios::binary);
+	if (!in)
+		throw(checkers_error("Unable to open bitbase file " + file_name));
+	load(in);
+}
+
+void Bitbase::load(std::istream& istr)
+{
+	char magic[sizeof(BB_MAGIC)];
+	int8_t rule, pieces;
+	uint64_t size;
+	loaded = false;
+	if (!istr.read(magic, sizeof(magic)) || std::memcmp(magic, BB_MAGIC, sizeof(magic)) != 0)
+		throw(checkers_error("Bitbase has wrong format"));
+	istr.read(reinterpret_cast<char*>(&rule), sizeof(rule));
+	istr.read(reinterpret_cast<char*>(&pieces), sizeof(pieces));
+	istr.read(reinterpret_cast<char*>(&size), sizeof(size));
+	if (!istr || (rule != RULES_DEFAULT && rule != RULES_ENGLISH) || pieces < 2 || pieces > MAX_PIECES)
+		throw(checkers_error("Bitbase header is corrupted"));
+	rules = static_cast<game_rules>(rule);
+	max_pieces = pieces;
+	_build_layout();
+	if (size != data.size() || !istr.read(data.as<char>(), size))
+		throw(checkers_error("Bitbase data is corrupted"));
+	loaded = true;
+}
+
+void Bitbase::save(const std::string& file_name) const
+{
+	std::ofstream out(file_name, std::ios::binary);
+	if (!out)
+		throw(checkers_error("Unable to create bitbase file " + file_name));
+	save(out);
+}
+
+void Bitbase::save(std::ostream& ostr) const
+{
+	const int8_t rule = rules, pieces = max_pieces;
+	const uint64_t size = data.size();
+	ostr.write(BB_MAGIC, sizeof(BB_MAGIC));
+	ostr.write(reinterpret_cast<const char*>(&rule), sizeof(rule));
+	ostr.write(reinterpret_cast<const char*>(&pieces), sizeof(pieces));
+	ostr.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	ostr.write(data.as<const char>(), size);
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// bitbase.h, version 1.8
+
+#pragma once
+#ifndef _BITBASE_H
+#define _BITBASE_H
+#include <vector>
+#include <string>
+#include <iostream>
+#include "board.h"
+#include "large_memory.h"
+
+// Win/draw/loss value of a position for the side to move. WDL_NONE means that position is not covered
+enum wdl : int8_t { WDL_DRAW = 0, WDL_WIN, WDL_LOSS, WDL_NONE };
+
+// In-memory win/draw/loss bitbase for positions with small piece count (2 bits per position).
+// Positions are indexed by material signature (counts of white simple, white queen, black simple and
+// black queen pieces for side to move being white) and combinatorial ranks of each piece group's squares.
+// Positions with black to move are probed through rotated board with colours swapped.
+// Queens-only positions are won or lost only if the game ends within the consecutive queen moves limit
+// (counted from the position, so it is assumed that the last move before it was made by a simple piece)
+class Bitbase
+{
+public:
+	static constexpr int MAX_PIECES = 6; // Maximum supported piece count (limits index tables)
+	static constexpr int SQUARE_COUNT = 32; // Count of playable squares
+	// Constructor
+	Bitbase(void) noexcept;
+	Bitbase(const Bitbase&) = delete;
+	Bitbase& operator=(const Bitbase&) = delete;
+	// Destructor
+	~Bitbase(void) noexcept;
+	// Public member functions
+	inline bool is_loaded(void) const noexcept;
+	inline game_rules get_rules(void) const noexcept;
+	inline int get_max_pieces(void) const noexcept;
+	inline size_t get_size(void) const noexcept; // Size of data in bytes
+	// Returns value of board's position with given colour to move (WDL_NONE if it is not covered)
+	inline wdl probe(const Board&, colour) const noexcept;
+	// Generates bitbase for given rules and maximum piece count. Optional stream receives progress log
+	void generate(game_rules, int, std::ostream* = nullptr);
+	void load(const std::string&); // Loads bitbase from given file
+	void load(std::istream&); // Loads bitbase from given stream in binary format
+	void save(const std::string&) const; // Saves bitbase to given file
+	void save(std::ostream&) const; // Outputs bitbase to given stream in binary format
+private:
+	struct Signature
+	{
+		int8_t count[4]; // Counts of white simple, white queen, black simple and black queen pieces
+	};
+	// Index of signature in table_offset array
+	static constexpr inline int sig_idx(int, int, int, int) noexcept;
+	static inline int square(Position) noexcept;
+	// Helper functions
+	void _build_layout(void);
+	inline uint64_t _index(const int8_t(&)[4], const int(&)[4][MAX_PIECES]) const noexcept;
+	// Finds signature index and index inside its table of board's position with given colour to move.
+	// Returns false if the position is not covered
+	inline bool _locate(const Board&, colour, int&, uint64_t&) const noexcept;
+	inline wdl _get(uint64_t) const noexcept;
+	inline void _set(uint64_t, wdl) noexcept;
+	// Members
+	game_rules rules; // Rules the bitbase was generated for
+	int max_pieces; // Maximum piece count covered
+	bool loaded; // Whether bitbase contains valid data
+	std::vector<uint64_t> table_offset; // Offset (in positions) of each signature's table
+	std::vector<uint64_t> table_size; // Size (in positions) of each signature's table
+	std::vector<Signature> signatures; // All covered signatures in generation order
+	// Packed values, 4 positions per byte. The bitbase is shared by search threads, so its pages are spread across NUMA nodes
+	LargeMemory data;
+	friend class BitbaseBuilder;
+};
+
+// Binomial coefficients C(n, k) for combinatorial indexing of piece squares
+struct BinomialTable
+{
+	uint64_t value[Bitbase::SQUARE_COUNT + 1][Bitbase::MAX_PIECES + 1];
+	constexpr BinomialTable(void)
+		: value()
+	{
+		for (int n = 0; n <= Bitbase::SQUARE_COUNT; ++n)
+		{
+			value[n][0] = 1;
+			for (int k = 1; k <= Bitbase::MAX_PIECES; ++k)
+				value[n][k] = (n == 0 ? 0 : value[n - 1][k - 1] + value[n - 1][k]);
+		}
+	}
+	constexpr inline uint64_t operator()(int n, int k) const noexcept
+	{
+		return value[n][k];
+	}
+};
+
+constexpr BinomialTable BB_BINOMIAL;
+
+inline bool Bitbase::is_loaded(void) const noexcept
+{
+	return loaded;
+}
+
+inline game_rules Bitbase::get_rules(void) const noexcept
+{
+	return rules;
+}
+
+inline int Bitbase::get_max_pieces(void) const noexcept
+{
+	return max_pieces;
+}
+
+inline size_t Bitbase::get_size(void) const noexcept
+{
+	return data.size();
+}
+
+constexpr inline int Bitbase::sig_idx(int ws, int wq, int bs, int bq) noexcept
+{
+	return ((ws * (MAX_PIECES + 1) + wq) * (MAX_PIECES + 1) + bs) * (MAX_PIECES + 1) + bq;
+}
+
+inline int Bitbase::square(Position pos) noexcept
+{
+	return (pos.get_row() << 2) + (pos.get_column() >> 1);
+}
+
+inline wdl Bitbase::_get(uint64_t idx) const noexcept
+{
+	return static_cast<wdl>((data.as<uint8_t>()[idx >> 2] >> ((idx & 3) << 1)) & 3);
+}
+
+inline void Bitbase::_set(uint64_t idx, wdl value) noexcept
+{
+	uint8_t& byte = data.as<uint8_t>()[idx >> 2];
+	byte = (byte & ~(3 << ((idx & 3) << 1))) | (value << ((idx & 3) << 1));
+}
+
+// Computes index of position (given as signature and sorted squares of each piece group) inside its table
+inline uint64_t Bitbase::_index(const int8_t(&count)[4], const int(&squares)[4][MAX_PIECES]) const noexcept
+{
+	uint64_t idx = 0;
+	for (int group = 0; group < 4; ++group)
+	{
+		uint64_t rank = 0;
+		for (int i = 0; i < count[group]; ++i)
+			rank += BB_BINOMIAL(squares[group][i], i + 1);
+		idx = idx * BB_BINOMIAL(SQUARE_COUNT, count[group]) + rank;
+	}
+	return idx;
+}
+
+inline bool Bitbase::_locate(const Board& board, colour turn, int& sig, uint64_t& idx) const noexcept
+{
+	if (!loaded || board.all_piece_count > max_pieces || board.rules != rules || board.misere)
+		return false;
+	// Piece groups in order of signature (side to move is considered white)
+	const piece_type group_type[4] = { turn_simple(turn), turn_queen(turn),
+		turn_simple(opposite(turn)), turn_queen(opposite(turn)) };
+	int8_t count[4];
+	int squares[4][MAX_PIECES];
+	for (int group = 0; group < 4; ++group)
+	{
+		count[group] = board.piece_count[group_type[group]];
+		for (int i = 0; i < count[group]; ++i)
+		{
+			// Rotate the board if black is to move
+			int sq = square(board.piece_list[group_type[group]][i]);
+			if (turn == BLACK)
+				sq = SQUARE_COUNT - 1 - sq;
+			// Insertion sort (groups are tiny)
+			int j = i;
+			for (; j > 0 && squares[group][j - 1] > sq; --j)
+				squares[group][j] = squares[group][j - 1];
+			squares[group][j] = sq;
+		}
+	}
+	if (count[0] + count[1] == 0 || count[2] + count[3] == 0)
+		return false;
+	sig = sig_idx(count[0], count[1], count[2], count[3]);
+	idx = _index(count, squares);
+	return true;
+}
+
+inline wdl Bitbase::probe(const Board& board, colour turn) const noexcept
+{
+	int sig;
+	uint64_t idx;
+	return _locate(board, turn, sig, idx) ? _get(table_offset[sig] + idx) : WDL_NONE;
+}
+
+#endif
\ No newline at end of file
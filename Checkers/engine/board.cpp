@@ -1,245 +1,489 @@
-/*
-========================================================================
-Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
-
-This file is part of Checkers source code
-
-Checkers is free software : you can redistribute it and / or modify
-it under the terms of the GNU General Public License as published by
-the Free Software Foundation, either version 3 of the License, or
-(at your option) any later version.
-
-Checkers is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with Checkers.If not, see <http://www.gnu.org/licenses/>
-========================================================================
-*/
-
-// board.cpp, version 1.7
-
-#include "board.h"
-#include "misc.h"
-#include <random>
-#include <sstream>
-
-Board::Board(game_rules rule) noexcept
-{
-	init_zobrist();
-	restart(rule);
-}
-
-Board::~Board(void) noexcept = default;
-
-void Board::init_zobrist(void) noexcept
-{
-	auto gen = std::linear_congruential_engine<uint64_t, 172687568145817, 2949769574,
-		0xffffffffffffffff>();
-	for (int i = 0; i < 64; ++i)
-	{
-		zobrist_hash[WHITE_SIMPLE][i] = gen();
-		zobrist_hash[WHITE_QUEEN][i] = gen();
-		zobrist_hash[BLACK_SIMPLE][i] = gen();
-		zobrist_hash[BLACK_QUEEN][i] = gen();
-	}
-}
-
-void Board::_clear_board(void)
-{
-	cur_hash = 0;
-	all_piece_count = 0;
-	for (int i = 0; i < PT_COUNT; ++i)
-		piece_count[i] = 0;
-	for (int i = 0; i < 8; ++i)
-		for (int j = 0; j < 8; ++j)
-			board[i][j] = Piece(PT_EMPTY), index[i][j] = 0;
-}
-
-void Board::restart(game_rules rule, bool mis) noexcept
-{
-	_clear_board();
-	for (int i = 0; i < 8; i += 2)
-	{
-		_put_piece(Position(0, i), Piece(WHITE_SIMPLE));
-		_put_piece(Position(2, i), Piece(WHITE_SIMPLE));
-		_put_piece(Position(6, i), Piece(BLACK_SIMPLE));
-	}
-	for (int i = 1; i < 8; i += 2)
-	{
-		_put_piece(Position(1, i), Piece(WHITE_SIMPLE));
-		_put_piece(Position(5, i), Piece(BLACK_SIMPLE));
-		_put_piece(Position(7, i), Piece(BLACK_SIMPLE));
-	}
-	rules = rule;
-	white_turn = true;
-	misere = mis;
-	cur_ply = 0;
-	state = GAME_CONTINUE;
-	(decltype(_position_count)()).swap(_position_count);
-	consecutiveQM.resize(1);
-	consecutiveQM[0] = 0;
-	switch (rules)
-	{
-	case RULES_DEFAULT:
-		move_gen = std::make_unique<MoveGenDefault>(*this);
-		break;
-	case RULES_ENGLISH:
-		move_gen = std::make_unique<MoveGenEnglish>(*this);
-		break;
-	}
-}
-
-bool Board::legal_move(Move& move) const
-{
-	std::vector<Move> moves;
-	get_all_moves(moves);
-	auto move_it = std::find(moves.begin(), moves.end(), move);
-	if (move_it == moves.end())
-		return false;
-	move.set_info_from(*move_it);
-	return true;
-}
-
-void Board::_update_game_state(void)
-{
-	std::vector<Move> vec;
-	get_all_moves(vec);
-	if (vec.size() == 0)
-		state = no_moves_state();
-	else
-	{
-		bool draw = consecutiveQM[cur_ply] >=
-			2 * DRAW_CONSECUTIVE_QUEEN_MOVES; // Because consequtiveQM really counts half-moves(plies)
-		if(!draw)
-			for (const auto& pos : _position_count)
-				if (pos.second >= DRAW_REPEATED_POS_COUNT)
-				{
-					draw = true;
-					break;
-				}
-		state = (draw ? DRAW : GAME_CONTINUE);
-	}
-}
-
-void Board::_proceed(Move& m)
-{
-	white_turn = !white_turn;
-	++_position_count[get_hash()];
-	if (consecutiveQM.size() <= cur_ply)
-		consecutiveQM.resize(cur_ply + 1);
-	if (m.get_original().is_queen())
-		consecutiveQM[cur_ply] = consecutiveQM[cur_ply - 1] + 1;
-	else
-		consecutiveQM[cur_ply] = 0;
-}
-
-void Board::_retreat(Move& m)
-{
-	white_turn = !white_turn;
-	if((--_position_count[get_hash()]) == 0)
-		_position_count.erase(get_hash());
-}
-
-void Board::_put_piece(Position pos, Piece piece)
-{
-	++all_piece_count;
-	index[pos.get_row()][pos.get_column()] = piece_count[piece.get_type()]++;
-	piece_list[piece.get_type()][index[pos.get_row()][pos.get_column()]] = pos;
-	board[pos.get_row()][pos.get_column()] = piece;
-	cur_hash ^= zobrist_hash[piece.get_type()][pos_idx(pos)];
-}
-
-void Board::_remove_piece(Position pos)
-{
-	Piece& cur = board[pos.get_row()][pos.get_column()];
-	cur_hash ^= zobrist_hash[cur.get_type()][pos_idx(pos)];
-	Position last_pos = piece_list[cur.get_type()][--piece_count[cur.get_type()]];
-	std::swap(piece_list[cur.get_type()][index[pos.get_row()][pos.get_column()]],
-		piece_list[cur.get_type()][piece_count[cur.get_type()]]);
-	index[last_pos.get_row()][last_pos.get_column()] = index[pos.get_row()][pos.get_column()];
-	board[pos.get_row()][pos.get_column()] = Piece(PT_EMPTY);
-	--all_piece_count;
-}
-
-void Board::_do_move(const Move& move)
-{
-	++cur_ply;
-	_remove_piece(move.old_pos());
-	_put_piece(move.new_pos(), move.get_become());
-	for (size_t i = 0; i < move.capt_size(); ++i)
-		_remove_piece(move.get_captured()[i].first);
-	prev_move_se.emplace(move.old_pos(), move.new_pos());
-}
-
-void Board::_undo_move(const Move& undo)
-{
-	--cur_ply;
-	_remove_piece(undo.new_pos());
-	_put_piece(undo.old_pos(), undo.get_original());
-	for (size_t i = 0; i < undo.capt_size(); ++i)
-		_put_piece(undo.get_captured()[i].first, undo.get_captured()[i].second);
-	prev_move_se.pop();
-}
-
-bool Board::read_pos(std::istream& istr, Position& pos)
-{
-	char col;
-	int row;
-	if (!(istr >> col >> row))
-		return false;
-	--row, col -= 'a';
-	if (row < 0 || row > 7 || col < 0 || col > 7 || (row & 1) != (col & 1))
-		throw(checkers_error("Position is illegal"));
-	pos.set_row(row);
-	pos.set_column(col);
-	return true;
-}
-
-void Board::write_pos(std::ostream& ostr, Position pos)
-{
-	ostr << (char)('a' + pos.get_column()) << pos.get_row() + 1;
-}
-
-bool Board::read_move(std::istream& istr, Move& move)
-{
-	char delim = '-';
-	Position pos;
-	std::string str_move;
-	move = Move();
-	if (!(istr >> str_move))
-		return false;
-	std::stringstream ss_move(str_move);
-	for (int cur_pos = 1; cur_pos == 1 || (ss_move >> delim); ++cur_pos)
-	{
-		if (delim != '-' && delim != ':')
-			throw(checkers_error("Move has wrong format"));
-		try
-		{
-			read_pos(ss_move, pos);
-		}
-		catch (const checkers_error& err)
-		{
-			throw(checkers_error("Position " + std::to_string(cur_pos) + ": " + err.what()));
-		}
-		move.add_step(pos);
-	}
-	if (move.size() == 1)
-		throw(checkers_error("Move cannot consist of only one position"));
-	return true;
-}
-
-void Board::write_move(std::ostream& ostr, const Move& move)
-{
-	if (move.size() == 0)
-		return;
-	const char delim = (move.capt_size() == 0 ? '-' : ':');
-	write_pos(ostr, move[0]);
-	for (size_t i = 1; i < move.size(); ++i)
-	{
-		ostr << delim;
-		write_pos(ostr, move[i]);
-	}
+/*
+========================================================================
+Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// board.cpp, version 1.8
+
+#include "board.h"
+#include "misc.h"
+#include "pdn.h"
+
+Board::Board(game_rules rule) noexcept
+{
+	restart(rule);
+}
+
+Board::~Board(void) noexcept = default;
+
+void Board::_clear_board(void)
+{
+	cur_hash = 0;
+	all_piece_count = 0;
+	for (int i = 0; i < PT_COUNT; ++i)
+		piece_count[i] = 0;
+	for (int i = 0; i < 8; ++i)
+		for (int j = 0; j < 8; ++j)
+			board[i][j] = Piece(PT_EMPTY), index[i][j] = 0;
+}
+
+void Board::restart(game_rules rule, bool mis) noexcept
+{
+	const bool new_move_gen = (move_gen == nullptr || rule != rules);
+	_clear_board();
+	for (int i = 0; i < 8; i += 2)
+	{
+		_put_piece(Position(0, i), Piece(WHITE_SIMPLE));
+		_put_piece(Position(2, i), Piece(WHITE_SIMPLE));
+		_put_piece(Position(6, i), Piece(BLACK_SIMPLE));
+	}
+	for (int i = 1; i < 8; i += 2)
+	{
+		_put_piece(Position(1, i), Piece(WHITE_SIMPLE));
+		_put_piece(Position(5, i), Piece(BLACK_SIMPLE));
+		_put_piece(Position(7, i), Piece(BLACK_SIMPLE));
+	}
+	rules = rule;
+	white_turn = true;
+	misere = mis;
+	cur_ply = 0;
+	state = GAME_CONTINUE;
+	(decltype(_position_count)()).swap(_position_count);
+	prev_move_se.clear();
+	consecutiveQM.resize(1);
+	consecutiveQM[0] = 0;
+	if (new_move_gen)
+		switch (rules)
+		{
+		case RULES_DEFAULT:
+			move_gen = std::make_unique<MoveGenDefault>(*this);
+			break;
+		case RULES_ENGLISH:
+			move_gen = std::make_unique<MoveGenEnglish>(*this);
+			break;
+		}
+}
+
+// Checks the path step by step against the board by the same rules as move generators, without generating
+// other moves. Capture is mandatory and capture sequence should be complete (a king of default rules should also
+// land on a square from which it can continue capturing, if there is such square behind the captured piece)
+bool Board::legal_move(Move& move) const
+{
+	const int steps = move.size() - 1;
+	if (steps < 1)
+		return false;
+	for (int i = 0; i <= steps; ++i) // 4-bit coordinates can't exceed 7, so only negative ones are off the board
+		if (move[i].row < 0 || move[i].column < 0)
+			return false;
+	const colour turn = (white_turn ? WHITE : BLACK);
+	const int forward = (white_turn ? 1 : -1), promotion_row = (white_turn ? 7 : 0);
+	const Position from = move[0];
+	move.original = board[from.row][from.column];
+	move.captured.clear();
+	if (move.original.get_colour() != turn)
+		return false;
+	bool queen = move.original.is_queen();
+	if (!has_capture())
+	{
+		const bool flying = (queen && rules == RULES_DEFAULT);
+		const int d_row = move[1].row - from.row, d_column = move[1].column - from.column, distance = std::abs(d_row);
+		if (steps != 1 || distance == 0 || distance != std::abs(d_column)
+			|| (queen ? !flying && distance != 1 : d_row != forward))
+			return false;
+		for (int k = 1; k <= distance; ++k)
+			if (board[from.row + k * d_row / distance][from.column + k * d_column / distance].get_type() != PT_EMPTY)
+				return false;
+		move.become = (!queen && move[1].row == promotion_row ? Piece(turn_queen(turn)) : move.original);
+		return true;
+	}
+	bool captured[8][8] = {};
+	tmp_assign<Piece> move_begin(const_cast<Piece&>(board[from.row][from.column]), Piece(PT_EMPTY)); // Because this position is empty when we move from it
+	for (int i = 0; i < steps; ++i)
+	{
+		const int row = move[i].row, column = move[i].column, row2 = move[i + 1].row, column2 = move[i + 1].column;
+		const int distance = std::abs(row2 - row), d_row = (row2 > row ? 1 : -1), d_column = (column2 > column ? 1 : -1);
+		if (distance < 2 || distance != std::abs(column2 - column)
+			|| (!(queen && rules == RULES_DEFAULT) && (distance != 2 || (rules == RULES_ENGLISH && !queen && d_row != forward))))
+			return false;
+		// Only a flying king passes empty squares before the captured piece
+		int k = 1;
+		if (queen && rules == RULES_DEFAULT)
+			while (k < distance && board[row + k * d_row][column + k * d_column].get_colour() < WHITE)
+				++k;
+		const int row1 = row + k * d_row, column1 = column + k * d_column;
+		if (k == distance || board[row1][column1].get_colour() != opposite(turn) || captured[row1][column1])
+			return false;
+		for (int l = k + 1; l <= distance; ++l)
+			if (board[row + l * d_row][column + l * d_column].get_type() != PT_EMPTY)
+				return false;
+		captured[row1][column1] = true;
+		move.captured.add(std::make_pair(Position(row1, column1), board[row1][column1]));
+		if (queen && rules == RULES_DEFAULT && !_can_capture(row2, column2, true, captured))
+			for (int l = k + 1; row + l * d_row >= 0 && row + l * d_row <= 7 && column + l * d_column >= 0
+				&& column + l * d_column <= 7 && board[row + l * d_row][column + l * d_column].get_type() == PT_EMPTY; ++l)
+				if (_can_capture(row + l * d_row, column + l * d_column, true, captured))
+					return false;
+		if (!queen && row2 == promotion_row)
+		{
+			queen = true;
+			// In english checkers move is stopped when piece becomes queen
+			if (rules == RULES_ENGLISH)
+			{
+				move.become = Piece(turn_queen(turn));
+				return i + 1 == steps;
+			}
+		}
+	}
+	move.become = (queen ? Piece(turn_queen(turn)) : move.original);
+	return !_can_capture(move[steps].row, move[steps].column, queen, captured);
+}
+
+bool Board::_can_capture(int row, int column, bool queen, const bool(&captured)[8][8]) const noexcept
+{
+	static constexpr int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
+	const colour opponent = (white_turn ? BLACK : WHITE);
+	for (int dir = 0; dir < 4; ++dir)
+	{
+		// Simple pieces of english checkers capture only forward
+		if (rules == RULES_ENGLISH && !queen && d_row[dir] != (white_turn ? 1 : -1))
+			continue;
+		int row1 = row + d_row[dir], column1 = column + d_column[dir];
+		if (queen && rules == RULES_DEFAULT)
+			while (row1 > 0 && row1 < 7 && column1 > 0 && column1 < 7 && board[row1][column1].get_colour() < WHITE)
+				row1 += d_row[dir], column1 += d_column[dir];
+		const int row2 = row1 + d_row[dir], column2 = column1 + d_column[dir];
+		if (row2 >= 0 && row2 <= 7 && column2 >= 0 && column2 <= 7 && board[row1][column1].get_colour() == opponent
+			&& !captured[row1][column1] && board[row2][column2].get_type() == PT_EMPTY)
+			return true;
+	}
+	return false;
+}
+
+void Board::_update_game_state(void)
+{
+	if (!has_any_move())
+		state = no_moves_state();
+	else
+	{
+		bool draw = consecutiveQM[cur_ply] >=
+			2 * DRAW_CONSECUTIVE_QUEEN_MOVES; // Because consequtiveQM really counts half-moves(plies)
+		if(!draw)
+			for (const auto& pos : _position_count)
+				if (pos.second >= DRAW_REPEATED_POS_COUNT)
+				{
+					draw = true;
+					break;
+				}
+		state = (draw ? DRAW : GAME_CONTINUE);
+	}
+}
+
+void Board::_proceed(Move& m)
+{
+	white_turn = !white_turn;
+	++_position_count[get_hash()];
+	if (consecutiveQM.size() <= cur_ply)
+		consecutiveQM.resize(cur_ply + 1);
+	if (m.get_original().is_queen())
+		consecutiveQM[cur_ply] = consecutiveQM[cur_ply - 1] + 1;
+	else
+		consecutiveQM[cur_ply] = 0;
+}
+
+void Board::_retreat(Move& m)
+{
+	white_turn = !white_turn;
+	if((--_position_count[get_hash()]) == 0)
+		_position_count.erase(get_hash());
+}
+
+void Board::_put_piece(Position pos, Piece piece)
+{
+	++all_piece_count;
+	index[pos.get_row()][pos.get_column()] = piece_count[piece.get_type()]++;
+	piece_list[piece.get_type()][index[pos.get_row()][pos.get_column()]] = pos;
+	board[pos.get_row()][pos.get_column()] = piece;
+	cur_hash ^= ZOBRIST(piece.get_type(), pos_idx(pos));
+}
+
+void Board::_remove_piece(Position pos)
+{
+	Piece& cur = board[pos.get_row()][pos.get_column()];
+	cur_hash ^= ZOBRIST(cur.get_type(), pos_idx(pos));
+	Position last_pos = piece_list[cur.get_type()][--piece_count[cur.get_type()]];
+	std::swap(piece_list[cur.get_type()][index[pos.get_row()][pos.get_column()]],
+		piece_list[cur.get_type()][piece_count[cur.get_type()]]);
+	index[last_pos.get_row()][last_pos.get_column()] = index[pos.get_row()][pos.get_column()];
+	board[pos.get_row()][pos.get_column()] = Piece(PT_EMPTY);
+	--all_piece_count;
+}
+
+void Board::_do_move(const Move& move)
+{
+	++cur_ply;
+	_remove_piece(move.old_pos());
+	_put_piece(move.new_pos(), move.get_become());
+	for (size_t i = 0; i < move.capt_size(); ++i)
+		_remove_piece(move.get_captured()[i].first);
+	prev_move_se.emplace(move.old_pos(), move.new_pos());
+}
+
+void Board::_undo_move(const Move& undo)
+{
+	--cur_ply;
+	_remove_piece(undo.new_pos());
+	_put_piece(undo.old_pos(), undo.get_original());
+	for (size_t i = 0; i < undo.capt_size(); ++i)
+		_put_piece(undo.get_captured()[i].first, undo.get_captured()[i].second);
+	prev_move_se.pop();
+}
+
+namespace
+{
+	// Reads square of position string as its number in numeric notation (algebraic one is accepted too)
+	bool read_fen_square(const char*& cur, const char* end, game_rules rule, int& number) noexcept
+	{
+		if (cur != end && *cur >= 'a' && *cur <= 'h')
+		{
+			if (end - cur < 2 || cur[1] < '1' || cur[1] > '8' || ((cur[0] - 'a') & 1) != ((cur[1] - '1') & 1))
+				return false;
+			number = pdn_square(rule, Position(cur[1] - '1', cur[0] - 'a'));
+			cur += 2;
+			return true;
+		}
+		number = 0;
+		const char* begin = cur;
+		for (; cur != end && *cur >= '0' && *cur <= '9' && cur - begin < 2; ++cur)
+			number = number * 10 + (*cur - '0');
+		return cur != begin && number >= 1 && number <= 32;
+	}
+
+	inline char* write_fen_number(char* out, int number) noexcept
+	{
+		if (number >= 10)
+			*out++ = char('0' + number / 10);
+		*out++ = char('0' + number % 10);
+		return out;
+	}
+}
+
+// Position string is FEN of PDN, optionally preceded by GameType (25 or 21, followed by M in misere game):
+//   [<game type>[M]:]<side to move>:W<squares>:B<squares>[.]
+// Colours are PDN's ones (so in english checkers B is the first player, which is engine's white). Squares are
+// comma-separated numbers of numeric notation (or algebraic squares), K marks a king and <a>-<b> is a range
+// of men. Without game type the rules and game type of the board are kept. E.g., initial position is
+//   25:W:W21,22,23,24,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,8,9,10,11,12
+bool Board::_parse_fen(const char* cur, const char* end, game_rules& rule, bool& mis,
+	bool& white, Piece(&squares)[32]) const noexcept
+{
+	rule = rules;
+	mis = misere;
+	if (cur != end && *cur >= '0' && *cur <= '9')
+	{
+		int game_type = 0;
+		for (; cur != end && *cur >= '0' && *cur <= '9' && game_type < 100; ++cur)
+			game_type = game_type * 10 + (*cur - '0');
+		if (game_type == PdnReader::GAME_TYPE_RUSSIAN)
+			rule = RULES_DEFAULT;
+		else if (game_type == PdnReader::GAME_TYPE_ENGLISH)
+			rule = RULES_ENGLISH;
+		else
+			return false;
+		mis = (cur != end && *cur == 'M');
+		if (mis)
+			++cur;
+		if (cur == end || *cur++ != ':')
+			return false;
+	}
+	if (cur == end || (*cur != 'W' && *cur != 'B'))
+		return false;
+	const colour pdn_w = pdn_white(rule);
+	white = ((*cur++ == 'W') == (pdn_w == WHITE));
+	int count[PT_COUNT] = {};
+	for (auto& piece : squares)
+		piece = Piece(PT_EMPTY);
+	while (cur != end && *cur == ':')
+	{
+		if (++cur == end || (*cur != 'W' && *cur != 'B'))
+			return false;
+		const colour col = (*cur++ == 'W' ? pdn_w : opposite(pdn_w));
+		if (cur == end || *cur == ':' || *cur == '.')
+			continue; // No pieces of this colour
+		for (;;)
+		{
+			const bool queen = (*cur == 'K');
+			int first, last;
+			if (queen)
+				++cur;
+			if (!read_fen_square(cur, end, rule, first))
+				return false;
+			last = first;
+			if (!queen && cur != end && *cur == '-' && (!read_fen_square(++cur, end, rule, last) || last < first))
+				return false;
+			const piece_type pt = (queen ? turn_queen(col) : turn_simple(col));
+			for (int number = first; number <= last; ++number)
+			{
+				const Position pos = pdn_position(rule, number);
+				Piece& piece = squares[(pos.get_row() << 2) + (pos.get_column() >> 1)];
+				// Simple pieces can't stay at their promotion row and piece list has room for 12 pieces of each type
+				if (piece.get_type() != PT_EMPTY || count[pt] == 12
+					|| (!queen && pos.get_row() == (col == WHITE ? 7 : 0)))
+					return false;
+				piece = Piece(pt);
+				++count[pt];
+			}
+			if (cur == end || *cur != ',')
+				break;
+			++cur;
+		}
+	}
+	if (cur != end && *cur == '.')
+		++cur;
+	return cur == end;
+}
+
+void Board::_set_pieces(bool white, const Piece(&squares)[32])
+{
+	_clear_board();
+	white_turn = white;
+	for (int sq = 0; sq < 32; ++sq)
+		if (squares[sq].get_type() != PT_EMPTY)
+		{
+			const int row = sq >> 2;
+			_put_piece(Position(row, ((sq & 3) << 1) + (row & 1)), squares[sq]);
+		}
+	_update_game_state();
+}
+
+bool Board::set_fen(const char* begin, const char* end)
+{
+	game_rules rule;
+	bool mis, white;
+	Piece squares[32];
+	if (!_parse_fen(begin, end, rule, mis, white, squares))
+		return false;
+	restart(rule, mis);
+	_set_pieces(white, squares);
+	return true;
+}
+
+// Buffer should have at least FEN_BUFFER_SIZE chars. Pieces are written in order of their squares
+size_t Board::get_fen(char* buffer, bool with_rules) const noexcept
+{
+	char* out = buffer;
+	if (with_rules)
+	{
+		out = write_fen_number(out, rules == RULES_ENGLISH ? PdnReader::GAME_TYPE_ENGLISH : PdnReader::GAME_TYPE_RUSSIAN);
+		if (misere)
+			*out++ = 'M';
+		*out++ = ':';
+	}
+	const colour pdn_w = pdn_white(rules);
+	*out++ = ((white_turn ? WHITE : BLACK) == pdn_w ? 'W' : 'B');
+	for (colour col : { pdn_w, opposite(pdn_w) })
+	{
+		*out++ = ':';
+		*out++ = (col == pdn_w ? 'W' : 'B');
+		bool first = true;
+		for (int number = 1; number <= 32; ++number)
+		{
+			const Position pos = pdn_position(rules, number);
+			const Piece piece = board[pos.get_row()][pos.get_column()];
+			if (piece.get_colour() != col)
+				continue;
+			if (!first)
+				*out++ = ',';
+			first = false;
+			if (piece.is_queen())
+				*out++ = 'K';
+			out = write_fen_number(out, number);
+		}
+	}
+	*out = '\0';
+	return out - buffer;
+}
+
+bool Board::read_pos(std::istream& istr, Position& pos)
+{
+	char col;
+	int row;
+	if (!(istr >> col >> row))
+		return false;
+	--row, col -= 'a';
+	if (row < 0 || row > 7 || col < 0 || col > 7 || (row & 1) != (col & 1))
+		throw(checkers_error("Position is illegal"));
+	pos.set_row(row);
+	pos.set_column(col);
+	return true;
+}
+
+void Board::write_pos(std::ostream& ostr, Position pos)
+{
+	ostr << (char)('a' + pos.get_column()) << pos.get_row() + 1;
+}
+
+bool Board::read_move(std::istream& istr, Move& move)
+{
+	std::string str_move;
+	move = Move();
+	if (!(istr >> str_move))
+		return false;
+	PdnMove parsed;
+	PdnReader::parse_move(str_move.data(), str_move.data() + str_move.size(), false, RULES_DEFAULT, parsed);
+	move.path = parsed.squares;
+	return true;
+}
+
+void Board::write_move(std::ostream& ostr, const Move& move)
+{
+	if (move.size() == 0)
+		return;
+	const char delim = (move.capt_size() == 0 ? '-' : ':');
+	write_pos(ostr, move[0]);
+	for (size_t i = 1; i < move.size(); ++i)
+	{
+		ostr << delim;
+		write_pos(ostr, move[i]);
+	}
+}
+
+void Board::read_rules(std::istream& istr, game_rules& rule, bool& mis)
+{
+	std::string str;
+	istr >> str;
+	if (str == "DEFAULT_RULES")
+		rule = RULES_DEFAULT;
+	else if (str == "ENGLISH_RULES")
+		rule = RULES_ENGLISH;
+	else
+		throw(checkers_error("Rules should be either DEFAULT_RULES or ENGLISH_RULES"));
+	istr >> str;
+	if (str == "NORMAL_GAME")
+		mis = false;
+	else if (str == "MISERE_GAME")
+		mis = true;
+	else
+		throw(checkers_error("Game type should be either NORMAL_GAME or MISERE_GAME"));
+}
+
+void Board::write_rules(std::ostream& ostr, game_rules rule, bool mis)
+{
+	ostr << (rule == RULES_DEFAULT ? "DEFAULT_RULES " : "ENGLISH_RULES ")
+		<< (mis ? "MISERE_GAME\n" : "NORMAL_GAME\n");
 }
\ No newline at end of file
@@ -1,194 +1,295 @@
-/*
-========================================================================
-Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
-
-This file is part of Checkers source code
-
-Checkers is free software : you can redistribute it and / or modify
-it under the terms of the GNU General Public License as published by
-the Free Software Foundation, either version 3 of the License, or
-(at your option) any later version.
-
-Checkers is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with Checkers.If not, see <http://www.gnu.org/licenses/>
-========================================================================
-*/
-
-// board.h, version 1.7
-
-#pragma once
-#ifndef _BOARD_H
-#define _BOARD_H
-#include <vector>
-#include <unordered_map>
-#include <memory>
-#include "move_gen.h"
-
-enum game_state : int8_t { GAME_CONTINUE, DRAW, WHITE_WIN, BLACK_WIN };
-enum game_rules : int8_t { RULES_DEFAULT, RULES_ENGLISH };
-
-class Board
-{
-	friend class MoveGenDefault;
-	friend class MoveGenEnglish;
-public:
-	static constexpr int DRAW_REPEATED_POS_COUNT = 3; // Count of repeated positions during the game for declaring draw
-	static constexpr int DRAW_CONSECUTIVE_QUEEN_MOVES = 15; // Count of consecutive queen-only moves(from both players) for declaring draw
-	// Constructor
-	Board(game_rules = RULES_DEFAULT) noexcept;
-	// Destructor
-	virtual ~Board(void) noexcept;
-	// Public member functions
-	inline uint64_t get_hash(void) const noexcept;
-	inline game_rules get_rules(void) const noexcept;
-	inline bool get_white_turn(void) const noexcept;
-	inline bool get_misere(void) const noexcept;
-	inline game_state get_state(void) const noexcept;
-	inline int16_t get_current_ply(void) const noexcept;
-	inline int get_piece_count(piece_type) const noexcept;
-	inline int get_all_piece_count(void) const noexcept;
-	inline const Piece* operator[](size_t) const;
-	inline Piece get_cell(int, int) const;
-	inline Piece get_cell(const Position&) const;
-	virtual void restart(game_rules = RULES_DEFAULT, bool = false) noexcept; // Restarts game(resets board and state)
-	bool legal_move(Move&) const; // Returns whether given move is legal
-	template<colour = EMPTY, move_type = ALL>
-	inline void get_all_moves(std::vector<Move>&) const; // Outputs to given vector all possible moves
-	template<colour TURN, move_type = ALL>
-	inline std::enable_if_t<!(TURN == EMPTY || TURN == SHADOW),
-		void> get_all_moves(MoveList&) const; // Outputs to given move list all possible moves
-	template<colour TURN = EMPTY, move_type = ALL>
-	inline std::enable_if_t<TURN == EMPTY || TURN == SHADOW,
-		void> get_all_moves(MoveList&) const; // Outputs to given move list all possible moves
-	// Stream IO functions
-	static bool read_pos(std::istream&, Position&); // Reads position from given stream
-	static void write_pos(std::ostream&, Position); // Outputs move to given stream
-	static bool read_move(std::istream&, Move&); // Reads move from given stream
-	static void write_move(std::ostream&, const Move&); // Outputs move to given stream
-protected:
-	inline game_state no_moves_state(void) const noexcept;
-	void _update_game_state(void); // Updates current game state after a player's move
-	void _proceed(Move&); // Performs updating board information when performing given move
-	void _retreat(Move&); // Performs updating board information when undoing given move
-	// Clear the board
-	void _clear_board(void);
-	// Initialization of Zobrist keys
-	void init_zobrist(void) noexcept;
-	// Putting and removing pieces
-	virtual void _put_piece(Position, Piece);
-	virtual void _remove_piece(Position);
-	void _do_move(const Move&); // Performs a move using information from move_info structure
-	void _undo_move(const Move&); // Performs undoing of a move using information from move_info structure
-	bool white_turn; // Whether current turn is white's
-	bool misere; // Whether the game is misere(winner is the loser)
-	game_rules rules; // Game rules used now
-	game_state state; // Whether game is end and, if yes, who won it
-	Piece board[8][8]; // Board
-	Position piece_list[PT_COUNT][12]; // Piece list
-	int16_t cur_ply; // Current ply
-	int all_piece_count; // Overall piece count
-	int piece_count[PT_COUNT]; // Count of each piece
-	int index[8][8]; // Index of position in piece_list[{ position's piece type }] array
-	std::unique_ptr<MoveGen> move_gen;
-	uint64_t cur_hash; // Hash of current position
-	uint64_t zobrist_hash[PT_COUNT][64]; // Zobrist keys
-	std::vector<int> consecutiveQM; // Consequtive queen moves up to given ply
-	SVector<PseudoMove, 1024> prev_move_se; // Previous moves start and end positions in search 
-	std::unordered_map<uint64_t, int> _position_count; // How many times each position occured throughout the game(for detecting draws)
-};
-
-inline uint64_t Board::get_hash(void) const noexcept
-{
-	return cur_hash;
-}
-
-inline game_rules Board::get_rules(void) const noexcept
-{
-	return rules;
-}
-
-inline bool Board::get_white_turn(void) const noexcept
-{
-	return white_turn;
-}
-
-inline bool Board::get_misere(void) const noexcept
-{
-	return misere;
-}
-
-inline game_state Board::get_state(void) const noexcept
-{
-	return state;
-}
-
-inline int16_t Board::get_current_ply(void) const noexcept
-{
-	return cur_ply;
-}
-
-inline int Board::get_piece_count(piece_type pt) const noexcept
-{
-	if (pt < 0 || pt >= PT_COUNT)
-		return 0;
-	return piece_count[pt];
-}
-
-inline int Board::get_all_piece_count(void) const noexcept
-{
-	return all_piece_count;
-}
-
-inline game_state Board::no_moves_state(void) const noexcept
-{
-	return (white_turn ^ misere) ? BLACK_WIN : WHITE_WIN;
-}
-
-template<colour TURN, move_type MT>
-inline std::enable_if_t<!(TURN == EMPTY || TURN == SHADOW),
-	void> Board::get_all_moves(MoveList& moves) const
-{
-	move_gen->get_all_moves<TURN, MT>(moves);
-}
-
-template<colour TURN, move_type MT>
-inline std::enable_if_t<TURN == EMPTY || TURN == SHADOW,
-	void> Board::get_all_moves(MoveList& moves) const
-{
-	if (white_turn)
-		get_all_moves<WHITE, MT>(moves);
-	else
-		get_all_moves<BLACK, MT>(moves);
-}
-
-template<colour TURN, move_type MT>
-inline void Board::get_all_moves(std::vector<Move>& moves) const
-{
-	moves.clear();
-	MoveList moveList;
-	get_all_moves<TURN, MT>(moveList);
-	for (int i = 0; i < moveList.size(); ++i)
-		moves.push_back(moveList[i].move);
-}
-
-inline const Piece* Board::operator[](size_t idx) const
-{
-	return board[idx];
-}
-
-inline Piece Board::get_cell(int row, int col) const
-{
-	return board[row][col];
-}
-
-inline Piece Board::get_cell(const Position& pos) const
-{
-	return board[pos.row][pos.column];
-}
-
+/*
+========================================================================
+Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// board.h, version 1.8
+
+#pragma once
+#ifndef _BOARD_H
+#define _BOARD_H
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include "move_gen.h"
+
+enum game_state : int8_t { GAME_CONTINUE, DRAW, WHITE_WIN, BLACK_WIN };
+enum game_rules : int8_t { RULES_DEFAULT, RULES_ENGLISH };
+constexpr int8_t GAME_RULES_COUNT = RULES_ENGLISH + 1;
+
+// Zobrist keys of pieces on squares, generated at compile time (so boards don't initialize their own copies).
+// The sequence is the one of std::linear_congruential_engine<uint64_t, 172687568145817, 2949769574,
+// 0xffffffffffffffff> with default seed, which was used for them before
+struct ZobristTable
+{
+	uint64_t key[PT_COUNT][64];
+	constexpr ZobristTable(void)
+		: key()
+	{
+		const piece_type types[4] = { WHITE_SIMPLE, WHITE_QUEEN, BLACK_SIMPLE, BLACK_QUEEN };
+		uint64_t state = 1;
+		for (int i = 0; i < 64; ++i)
+			for (int t = 0; t < 4; ++t)
+				key[types[t]][i] = state = next(state);
+	}
+	constexpr inline uint64_t operator()(piece_type pt, int idx) const noexcept
+	{
+		return key[pt][idx];
+	}
+private:
+	static constexpr uint64_t MODULUS = 0xffffffffffffffff;
+	static constexpr uint64_t MULTIPLIER = 172687568145817;
+	static constexpr uint64_t INCREMENT = 2949769574;
+	// Returns (MULTIPLIER * x + INCREMENT) mod MODULUS. Since 2^64 is 1 modulo MODULUS,
+	// high and low halves of the 128-bit product are just added
+	static constexpr uint64_t next(uint64_t x) noexcept
+	{
+		const uint64_t a0 = MULTIPLIER & 0xffffffff, a1 = MULTIPLIER >> 32, x0 = x & 0xffffffff, x1 = x >> 32;
+		const uint64_t p00 = a0 * x0, p01 = a0 * x1, p10 = a1 * x0, p11 = a1 * x1;
+		const uint64_t mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+		const uint64_t low = (p00 & 0xffffffff) | (mid << 32), high = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+		return add_mod(add_mod(low % MODULUS, high % MODULUS), INCREMENT);
+	}
+	static constexpr uint64_t add_mod(uint64_t x, uint64_t y) noexcept
+	{
+		return (x >= MODULUS - y ? x - (MODULUS - y) : x + y);
+	}
+};
+
+constexpr ZobristTable ZOBRIST;
+
+class Board
+{
+	friend class MoveGen;
+	friend class MoveGenDefault;
+	friend class MoveGenEnglish;
+	friend class Bitbase;
+public:
+	static constexpr int DRAW_REPEATED_POS_COUNT = 3; // Count of repeated positions during the game for declaring draw
+	static constexpr int DRAW_CONSECUTIVE_QUEEN_MOVES = 15; // Count of consecutive queen-only moves(from both players) for declaring draw
+	static constexpr uint64_t ZOBRIST_BLACK_TURN = 0xd1b54a32d192ed03; // Full hash key of black to move
+	static constexpr uint64_t ZOBRIST_ENGLISH = 0x8cb92ba72f3d8dd7; // Full hash key of english rules
+	static constexpr uint64_t ZOBRIST_MISERE = 0xabc98388fb8fac03; // Full hash key of misere game
+	static constexpr int FEN_BUFFER_SIZE = 136; // Size of buffer which fits any position string (see set_fen)
+	// Constructor
+	Board(game_rules = RULES_DEFAULT) noexcept;
+	// Destructor
+	virtual ~Board(void) noexcept;
+	// Public member functions
+	inline uint64_t get_hash(void) const noexcept;
+	inline uint64_t get_full_hash(void) const noexcept;
+	inline uint64_t get_full_hash(colour) const noexcept;
+	inline uint64_t child_hash(const Move&) const noexcept; // Hash of position after given legal move
+	inline game_rules get_rules(void) const noexcept;
+	inline bool get_white_turn(void) const noexcept;
+	inline bool get_misere(void) const noexcept;
+	inline game_state get_state(void) const noexcept;
+	inline int16_t get_current_ply(void) const noexcept;
+	inline int get_piece_count(piece_type) const noexcept;
+	inline int get_all_piece_count(void) const noexcept;
+	inline const Piece* operator[](size_t) const;
+	inline Piece get_cell(int, int) const;
+	inline Piece get_cell(const Position&) const;
+	virtual void restart(game_rules = RULES_DEFAULT, bool = false) noexcept; // Restarts game(resets board and state)
+	bool legal_move(Move&) const; // Returns whether given move's path is legal (its information is filled then)
+	template<colour = EMPTY, move_type = ALL>
+	inline void get_all_moves(std::vector<Move>&) const; // Outputs to given vector all possible moves
+	template<colour TURN, move_type = ALL>
+	inline std::enable_if_t<!(TURN == EMPTY || TURN == SHADOW),
+		void> get_all_moves(MoveList&) const; // Outputs to given move list all possible moves
+	template<colour TURN = EMPTY, move_type = ALL>
+	inline std::enable_if_t<TURN == EMPTY || TURN == SHADOW,
+		void> get_all_moves(MoveList&) const; // Outputs to given move list all possible moves
+	// Cheap checks which don't generate moves (default colour means the side to move)
+	template<colour = EMPTY>
+	inline bool has_capture(void) const; // Returns whether given side has a capture-move
+	template<colour = EMPTY>
+	inline bool has_any_move(void) const; // Returns whether given side has any move
+	// Position strings (FEN of PDN with optional rules, see board.cpp). They are parsed and formatted without allocations
+	virtual bool set_fen(const char*, const char*); // Sets up given position. If it is malformed, returns false
+	size_t get_fen(char*, bool = true) const noexcept; // Writes position string (optionally with rules). Returns its length
+	// Stream IO functions
+	static bool read_pos(std::istream&, Position&); // Reads position from given stream
+	static void write_pos(std::ostream&, Position); // Outputs move to given stream
+	static bool read_move(std::istream&, Move&); // Reads move from given stream
+	static void write_move(std::ostream&, const Move&); // Outputs move to given stream
+	static void read_rules(std::istream&, game_rules&, bool&); // Reads rules and game type from given stream
+	static void write_rules(std::ostream&, game_rules, bool); // Outputs rules and game type to given stream
+protected:
+	inline game_state no_moves_state(void) const noexcept;
+	void _update_game_state(void); // Updates current game state after a player's move
+	// Returns whether piece of the side to move at given square (queen or not) can capture a piece which isn't marked as captured
+	bool _can_capture(int, int, bool, const bool(&)[8][8]) const noexcept;
+	void _proceed(Move&); // Performs updating board information when performing given move
+	void _retreat(Move&); // Performs updating board information when undoing given move
+	// Parses position string to rules, game type, side to move and pieces of playable squares (row * 4 + column / 2)
+	bool _parse_fen(const char*, const char*, game_rules&, bool&, bool&, Piece(&)[32]) const noexcept;
+	void _set_pieces(bool, const Piece(&)[32]); // Sets side to move and pieces of playable squares and updates game state
+	// Clear the board
+	virtual void _clear_board(void);
+	// Putting and removing pieces
+	virtual void _put_piece(Position, Piece);
+	virtual void _remove_piece(Position);
+	void _do_move(const Move&); // Performs a move using information from move_info structure
+	void _undo_move(const Move&); // Performs undoing of a move using information from move_info structure
+	bool white_turn; // Whether current turn is white's
+	bool misere; // Whether the game is misere(winner is the loser)
+	game_rules rules; // Game rules used now
+	game_state state; // Whether game is end and, if yes, who won it
+	Piece board[8][8]; // Board
+	Position piece_list[PT_COUNT][12]; // Piece list
+	int16_t cur_ply; // Current ply
+	int all_piece_count; // Overall piece count
+	int piece_count[PT_COUNT]; // Count of each piece
+	int index[8][8]; // Index of position in piece_list[{ position's piece type }] array
+	std::unique_ptr<MoveGen> move_gen;
+	uint64_t cur_hash; // Hash of current position
+	std::vector<int> consecutiveQM; // Consequtive queen moves up to given ply
+	SVector<PseudoMove, 1024> prev_move_se; // Previous moves start and end positions in search 
+	std::unordered_map<uint64_t, int> _position_count; // How many times each position occured throughout the game(for detecting draws)
+};
+
+inline uint64_t Board::get_hash(void) const noexcept
+{
+	return cur_hash;
+}
+
+// Hash of current position which also distinguishes side to move, rules and game type
+// (position hash alone doesn't, so it is suitable for keying persistent data, like opening books)
+inline uint64_t Board::get_full_hash(colour turn) const noexcept
+{
+	return cur_hash ^ (turn == BLACK ? ZOBRIST_BLACK_TURN : 0)
+		^ (rules == RULES_ENGLISH ? ZOBRIST_ENGLISH : 0) ^ (misere ? ZOBRIST_MISERE : 0);
+}
+
+inline uint64_t Board::get_full_hash(void) const noexcept
+{
+	return get_full_hash(white_turn ? WHITE : BLACK);
+}
+
+// Computed from keys of changed squares without performing the move (move should have information
+// about its pieces, like ones from move generator or checked by legal_move)
+inline uint64_t Board::child_hash(const Move& move) const noexcept
+{
+	uint64_t hash = cur_hash ^ ZOBRIST(move.get_original().get_type(), pos_idx(move.old_pos()))
+		^ ZOBRIST(move.get_become().get_type(), pos_idx(move.new_pos()));
+	for (int i = 0; i < move.capt_size(); ++i)
+		hash ^= ZOBRIST(move.get_captured()[i].second.get_type(), pos_idx(move.get_captured()[i].first));
+	return hash;
+}
+
+inline game_rules Board::get_rules(void) const noexcept
+{
+	return rules;
+}
+
+inline bool Board::get_white_turn(void) const noexcept
+{
+	return white_turn;
+}
+
+inline bool Board::get_misere(void) const noexcept
+{
+	return misere;
+}
+
+inline game_state Board::get_state(void) const noexcept
+{
+	return state;
+}
+
+inline int16_t Board::get_current_ply(void) const noexcept
+{
+	return cur_ply;
+}
+
+inline int Board::get_piece_count(piece_type pt) const noexcept
+{
+	if (pt < 0 || pt >= PT_COUNT)
+		return 0;
+	return piece_count[pt];
+}
+
+inline int Board::get_all_piece_count(void) const noexcept
+{
+	return all_piece_count;
+}
+
+inline game_state Board::no_moves_state(void) const noexcept
+{
+	return (white_turn ^ misere) ? BLACK_WIN : WHITE_WIN;
+}
+
+template<colour TURN, move_type MT>
+inline std::enable_if_t<!(TURN == EMPTY || TURN == SHADOW),
+	void> Board::get_all_moves(MoveList& moves) const
+{
+	move_gen->get_all_moves<TURN, MT>(moves);
+}
+
+template<colour TURN, move_type MT>
+inline std::enable_if_t<TURN == EMPTY || TURN == SHADOW,
+	void> Board::get_all_moves(MoveList& moves) const
+{
+	if (white_turn)
+		get_all_moves<WHITE, MT>(moves);
+	else
+		get_all_moves<BLACK, MT>(moves);
+}
+
+template<colour TURN>
+inline bool Board::has_capture(void) const
+{
+	return (TURN == WHITE || (TURN != BLACK && white_turn)) ?
+		move_gen->has_capture<WHITE>() : move_gen->has_capture<BLACK>();
+}
+
+template<colour TURN>
+inline bool Board::has_any_move(void) const
+{
+	return (TURN == WHITE || (TURN != BLACK && white_turn)) ?
+		move_gen->has_any_move<WHITE>() : move_gen->has_any_move<BLACK>();
+}
+
+template<colour TURN, move_type MT>
+inline void Board::get_all_moves(std::vector<Move>& moves) const
+{
+	moves.clear();
+	MoveList moveList;
+	get_all_moves<TURN, MT>(moveList);
+	for (int i = 0; i < moveList.size(); ++i)
+		moves.push_back(moveList[i].move);
+}
+
+inline const Piece* Board::operator[](size_t idx) const
+{
+	return board[idx];
+}
+
+inline Piece Board::get_cell(int row, int col) const
+{
+	return board[row][col];
+}
+
+inline Piece Board::get_cell(const Position& pos) const
+{
+	return board[pos.row][pos.column];
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// book.cpp, version 1.8
+
+#include "book.h"
+#include "misc.h"
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+
+namespace
+{
+	constexpr char BOOK_MAGIC[8] = { 'C', 'H', 'K', 'R', 'S', 'B', 'K', '1' };
+	// Header is padded to entry size so that entries stay aligned in the mapped file
+	struct BookHeader
+	{
+		char magic[8];
+		int8_t rules;
+		int8_t misere;
+		int8_t reserved[6];
+	};
+	static_assert(sizeof(BookHeader) == sizeof(BookEntry), "Book header should have size of an entry");
+}
+
+// Board which replays games for book building
+class BookReplay
+	: public Board
+{
+public:
+	using Board::Board;
+	void play(Move& move)
+	{
+		_do_move(move);
+		_proceed(move);
+		_update_game_state();
+	}
+};
+
+OpeningBook::OpeningBook(void) noexcept
+	: entries(nullptr), entry_count(0), rules(RULES_DEFAULT), misere(false)
+{}
+
+OpeningBook::~OpeningBook(void) noexcept = default;
+
+void OpeningBook::open(const std::string& file_name)
+{
+	close();
+	file.open(file_name);
+	BookHeader header;
+	if (file.size() < sizeof(header) || (file.size() - sizeof(header)) % sizeof(BookEntry) != 0)
+	{
+		file.close();
+		throw(checkers_error("Opening book has wrong size"));
+	}
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (std::memcmp(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0
+		|| (header.rules != RULES_DEFAULT && header.rules != RULES_ENGLISH))
+	{
+		file.close();
+		throw(checkers_error("Opening book has wrong format"));
+	}
+	rules = static_cast<game_rules>(header.rules);
+	misere = (header.misere != 0);
+	entries = reinterpret_cast<const BookEntry*>(file.data() + sizeof(header));
+	entry_count = (file.size() - sizeof(header)) / sizeof(BookEntry);
+}
+
+void OpeningBook::close(void) noexcept
+{
+	file.close();
+	entries = nullptr;
+	entry_count = 0;
+}
+
+size_t OpeningBook::find(uint64_t key, const BookEntry*& first) const noexcept
+{
+	const auto range = std::equal_range(begin(), end(), BookEntry{ key, 0, 0, 0, 0 },
+		[](const BookEntry& lhs, const BookEntry& rhs) { return lhs.key < rhs.key; });
+	first = range.first;
+	return range.second - range.first;
+}
+
+bool OpeningBook::probe(const Board& board, const MoveList& moves, Move& out, uint32_t random) const noexcept
+{
+	if (!is_open() || board.get_rules() != rules || board.get_misere() != misere)
+		return false;
+	const BookEntry* first;
+	const size_t count = find(board.get_full_hash(), first);
+	// Match book moves with legal ones (guards against hash collisions)
+	const auto legal_idx = [&moves](const BookEntry& entry) {
+		for (int i = 0; i < moves.size(); ++i)
+			if (pos_idx(moves[i].move.old_pos()) == entry.from && pos_idx(moves[i].move.new_pos()) == entry.to)
+				return i;
+		return -1;
+	};
+	uint64_t total = 0;
+	for (size_t i = 0; i < count; ++i)
+		if (legal_idx(first[i]) != -1)
+			total += first[i].points;
+	if (total == 0)
+		return false;
+	uint64_t pick = random % total;
+	for (size_t i = 0; ; ++i)
+	{
+		const int idx = legal_idx(first[i]);
+		if (idx == -1)
+			continue;
+		if (pick < first[i].points)
+		{
+			out = moves[idx].move;
+			return true;
+		}
+		pick -= first[i].points;
+	}
+}
+
+BookBuilder::BookBuilder(game_rules rule, bool mis)
+	: rules(rule), misere(mis)
+{}
+
+BookBuilder::~BookBuilder(void) noexcept = default;
+
+void BookBuilder::add_book(const OpeningBook& book)
+{
+	if (!book.is_open() || book.get_rules() != rules || book.get_misere() != misere)
+		throw(checkers_error("Merged opening book should have the same rules"));
+	for (const auto& entry : book)
+	{
+		Stats& cur = stats[std::make_pair(entry.key, uint16_t(entry.from << 8 | entry.to))];
+		cur.points += entry.points;
+		cur.games += entry.games;
+	}
+}
+
+bool BookBuilder::add_game(const std::vector<Move>& game, int max_ply, game_state result)
+{
+	BookReplay replay(rules);
+	replay.restart(rules, misere);
+	// Replay the whole game first, so that corrupted games don't contribute anything
+	std::vector<std::pair<uint64_t, uint16_t>> keys;
+	for (Move move : game)
+	{
+		if (replay.get_state() != GAME_CONTINUE || !replay.legal_move(move))
+			return false;
+		if (keys.size() < size_t(max_ply))
+			keys.emplace_back(replay.get_full_hash(), uint16_t(pos_idx(move.old_pos()) << 8 | pos_idx(move.new_pos())));
+		replay.play(move);
+	}
+	if (result == GAME_CONTINUE)
+		result = replay.get_state();
+	if (result == GAME_CONTINUE)
+		return true;
+	for (size_t ply = 0; ply < keys.size(); ++ply)
+	{
+		// Even plies are white's moves
+		const game_state mover_win = (ply % 2 == 0 ? WHITE_WIN : BLACK_WIN);
+		Stats& cur = stats[keys[ply]];
+		cur.points += (result == DRAW ? 1 : result == mover_win ? 2 : 0);
+		++cur.games;
+	}
+	return true;
+}
+
+size_t BookBuilder::save(const std::string& file_name, uint32_t min_games) const
+{
+	std::vector<BookEntry> entries;
+	for (const auto& cur : stats)
+	{
+		if (cur.second.games < min_games)
+			continue;
+		BookEntry entry{ cur.first.first, 0, 0, uint8_t(cur.first.second >> 8), uint8_t(cur.first.second & 0xff) };
+		// Scale statistics of too frequent moves down to the entry field limits
+		const uint64_t games = std::min<uint64_t>(cur.second.games, std::numeric_limits<uint16_t>::max());
+		entry.games = uint16_t(games);
+		entry.points = uint32_t(cur.second.points * games / cur.second.games);
+		entries.push_back(entry);
+	}
+	std::stable_sort(entries.begin(), entries.end(), [](const BookEntry& lhs, const BookEntry& rhs) {
+		return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.points > rhs.points);
+	});
+	std::ofstream out(file_name, std::ios::binary);
+	if (!out)
+		throw(checkers_error("Unable to create opening book file " + file_name));
+	BookHeader header = {};
+	std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+	header.rules = rules;
+	header.misere = misere;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(BookEntry));
+	if (!out)
+		throw(checkers_error("Unable to write opening book file " + file_name));
+	return entries.size();
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// book.h, version 1.8
+
+#pragma once
+#ifndef _BOOK_H
+#define _BOOK_H
+#include <string>
+#include <vector>
+#include <map>
+#include "board.h"
+#include "mapped_file.h"
+
+// Entry of binary opening book. Entries are sorted by key and entries of the same position by points in
+// descending order, so the book is probed with binary search directly over the memory-mapped file
+struct BookEntry
+{
+	uint64_t key; // Full hash of position (see Board::get_full_hash)
+	uint32_t points; // Sum of results of games with this move (2 for win and 1 for draw of side to move)
+	uint16_t games; // Count of games with this move
+	uint8_t from; // Index (see pos_idx) of move's start position
+	uint8_t to; // Index of move's end position
+};
+
+static_assert(sizeof(BookEntry) == 16, "Book entry should be 16 bytes");
+
+// Opening book which is memory-mapped from a binary file
+class OpeningBook
+{
+public:
+	// Constructor
+	OpeningBook(void) noexcept;
+	// Destructor
+	~OpeningBook(void) noexcept;
+	// Public member functions
+	inline bool is_open(void) const noexcept;
+	inline game_rules get_rules(void) const noexcept;
+	inline bool get_misere(void) const noexcept;
+	inline size_t size(void) const noexcept; // Count of entries
+	inline const BookEntry* begin(void) const noexcept;
+	inline const BookEntry* end(void) const noexcept;
+	void open(const std::string&); // Maps book from given file
+	void close(void) noexcept; // Unmaps the book
+	// Finds entries of position with given full hash. Returns their count and sets given pointer to the first one
+	size_t find(uint64_t, const BookEntry*&) const noexcept;
+	// Chooses move for board's current position among given legal moves with probability proportional to points.
+	// Last parameter is a random value. Returns false if position isn't in the book or has no scoring moves
+	bool probe(const Board&, const MoveList&, Move&, uint32_t) const noexcept;
+private:
+	MappedFile file;
+	const BookEntry* entries; // Entries which start right after the header in the mapped file
+	size_t entry_count;
+	game_rules rules; // Rules the book was built for
+	bool misere; // Whether the book was built for misere games
+};
+
+// Accumulates statistics of moves from games and other books and saves them as opening book
+class BookBuilder
+{
+public:
+	// Constructor
+	BookBuilder(game_rules = RULES_DEFAULT, bool = false);
+	// Destructor
+	~BookBuilder(void) noexcept;
+	// Public member functions
+	inline game_rules get_rules(void) const noexcept;
+	inline bool get_misere(void) const noexcept;
+	inline size_t size(void) const noexcept; // Count of distinct (position, move) pairs
+	void add_book(const OpeningBook&); // Merges entries of given book (it should have the same rules)
+	// Adds moves of given game (played from the initial position) up to given ply. Last parameter is the game
+	// result, by default it is the state after the last move and unfinished games are ignored.
+	// Returns false if game contains an illegal move
+	bool add_game(const std::vector<Move>&, int, game_state = GAME_CONTINUE);
+	// Saves the book to given file. Moves which were played in less than given number of games are omitted.
+	// Returns count of saved entries
+	size_t save(const std::string&, uint32_t = 1) const;
+private:
+	struct Stats
+	{
+		uint64_t points;
+		uint64_t games;
+	};
+	game_rules rules;
+	bool misere;
+	std::map<std::pair<uint64_t, uint16_t>, Stats> stats; // Keyed by position's full hash and move's (from << 8 | to)
+};
+
+inline bool OpeningBook::is_open(void) const noexcept
+{
+	return entries != nullptr;
+}
+
+inline game_rules OpeningBook::get_rules(void) const noexcept
+{
+	return rules;
+}
+
+inline bool OpeningBook::get_misere(void) const noexcept
+{
+	return misere;
+}
+
+inline size_t OpeningBook::size(void) const noexcept
+{
+	return entry_count;
+}
+
+inline const BookEntry* OpeningBook::begin(void) const noexcept
+{
+	return entries;
+}
+
+inline const BookEntry* OpeningBook::end(void) const noexcept
+{
+	return entries + entry_count;
+}
+
+inline game_rules BookBuilder::get_rules(void) const noexcept
+{
+	return rules;
+}
+
+inline bool BookBuilder::get_misere(void) const noexcept
+{
+	return misere;
+}
+
+inline size_t BookBuilder::size(void) const noexcept
+{
+	return stats.size();
+}
+
+#endif
\ No newline at end of file
@@ -1,342 +1,507 @@
-/*
-========================================================================
-Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
-
-This file is part of Checkers source code
-
-Checkers is free software : you can redistribute it and / or modify
-it under the terms of the GNU General Public License as published by
-the Free Software Foundation, either version 3 of the License, or
-(at your option) any later version.
-
-Checkers is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with Checkers.If not, see <http://www.gnu.org/licenses/>
-========================================================================
-*/
-
-// checkers.h, version 1.7
-
-#pragma once
-#ifndef _CHECKERS_H
-#define _CHECKERS_H
-#include <iostream>
-#include <vector>
-#include <list>
-#include <stack>
-#include <algorithm>
-#include <chrono>
-#include <fstream>
-#include "misc.h"
-#include "board.h"
-#include "tt.h"
-
-#define TIMEOUT_CHECK_ON true
-
-enum step_result : int8_t { STEP_ILLEGAL, STEP_ILLEGAL_NEW, STEP_PROCEED, STEP_FINISH };
-enum node_type : int8_t { NODE_PV, NODE_CUT, NODE_ALL };
-
-// Expected node type of child of node with given expected type in a null-window search
-constexpr inline node_type nw_child(node_type node) noexcept
-{
-	return node == NODE_CUT ? NODE_ALL : NODE_CUT;
-}
-
-class Checkers
-	: public Board
-{
-public:
-	static constexpr int TIME_CHECK_INTERVAL = 10000; // Interval(in number of calls to _pvs) between checking for timeout
-	static constexpr int16_t MAX_SCORE = 25000; // Max score(absolute value), which indicates special situations(win/loss, initial value etc)
-	static constexpr int16_t MAX_LOSE_SCORE = -MAX_SCORE + 1000; // Maximum score for loosing player
-	static constexpr int16_t MIN_WIN_SCORE = MAX_SCORE - 1000; // Minimum score for winning player
-	static constexpr int MAX_KILLERS = 3; // Maximum numbers of killers for killer heuristic(AI)
-	static constexpr int16_t NORMAL_WEIGHT = 100; // Weight of non-queen piece in score function
-	static constexpr int16_t QUEEN_WEIGHT = 280; // Weight of queen piece in score function
-	static constexpr int16_t NORMAL_WEIGHT_ENDGAME = 105; // Weight of non-queen piece in score function in endgame
-	static constexpr int16_t QUEEN_WEIGHT_ENDGAME = 325; // Weight of queen piece in score function in endgame
-	static constexpr int16_t RELMAT_MULT = 275; // Multiplier for relative material advantage
-	static constexpr int16_t DELTA_PRUNING_MARGIN = 300; // Safety margin for delta pruning in quiscence search
-	static constexpr int16_t LT_PRUNING_MARGIN = 265; // Safety margin for LT pruning
-	static constexpr int16_t STAND_PAT_MARGIN = 300; // Safety margin for stand-pat pruning
-	static constexpr int16_t FUTILITY_MARGIN = 300; // Futility pruning margin
-	static constexpr int MS_TT_MOVE = 1000000000; // Move order score for move from the transposition table
-	static constexpr int MS_KILLER_MOVE = 1000000; // Move order score for killer move
-	static constexpr int MS_COUNTERMOVE_BONUS = 1000; // Move order bonus for countermoves
-	static constexpr int MC_MOVES_CHECK = 5; // Count of moves to check in multi-cut pruning
-	static constexpr int MC_MOVES_PRUNE = 3; // Count of moves to prune in multi-cut pruning
-	static constexpr int8_t MC_REDUCTION = 3; // Reduction of depth in multi-cut pruning
-	static constexpr int8_t MC_MIN_DEPTH = 6; // Minimum depth where multi-cut pruning is applied
-	static constexpr int8_t LMR_MIN_DEPTH = 4; // Minimum search depth where late move reduction can be applied
-	static constexpr int8_t ETC_MIN_DEPTH = 4; // Minimum search depth where enhanced transposition cutoff can be applied
-	static constexpr int8_t PBCUT_DEPTH_REDUCTION = 4; // Reduction of depth for prob cut
-	static constexpr int8_t PBCUT_MIN_DEPTH = 8; // Minimum search depth where prob cut can be applied
-	static constexpr float DEFAULT_TIME_LIMIT = 5000.0f; // Maximum thinking time, ms
-	static constexpr int8_t UNBOUNDED_DEPTH = -1; // search_depth value indicating absence of search depth bound
-#if defined _DEBUG || defined DEBUG
-	static constexpr int8_t MAX_SEARCH_DEPTH = 20; // Maximum search depth of AI
-#else
-	static constexpr int8_t MAX_SEARCH_DEPTH = 120; // Maximum search depth of AI
-#endif
-	// Constructor
-	Checkers(game_rules = RULES_DEFAULT, bool = false) noexcept;
-	// Destructor
-	~Checkers(void) noexcept;
-	// Public member functions
-	inline int8_t get_search_depth(void) const noexcept;
-	inline float get_time_limit(void) const noexcept;
-	inline const Move& get_part_move(void) const noexcept;
-	inline size_t get_part_move_size(void) const noexcept;
-	inline const std::vector<Move>& get_part_possible_moves(void) const;
-	inline const Move& get_last_move(void) const;
-	inline colour current_turn_colour(void) const noexcept;
-	inline const Piece* operator[](size_t) const;
-	inline void set_search_depth(int8_t) noexcept;
-	inline void set_time_limit(float) noexcept;
-	bool move(Move&); // Function for inputing player's move
-	// Function for inputing player's move step-by-step. Returns
-	// STEP_ILLEGAL and discards information about move if the move is illegal,
-	// STEP_ILLEGAL_NEW if the move is illegal, but given position is a start for new(valid) move
-	// STEP_PROCEED if given step is valid(there is legal move beginning with inputted step sequence),
-	// STEP_FINISH if given step is valid and the whole move is finished
-	step_result step(const Position&);
-	// AI. Outputs computer's move to a first parameter and position score to a second.
-	// Returns search depth of the last iterative deepening iteration. Uses minimax algorithm with alpha-beta pruning
-	inline int8_t get_computer_move(Move&, int&);
-	inline int8_t get_computer_move(Move&);
-	void part_undo(void); // Undoing of current unfinished part move(inputted with step function)
-	void undo_move(void); // Undo last move
-	void redo_move(void); // Redo last undone move
-	void perform_computer_move(void); // AI. Performs computer move
-	void restart(game_rules = RULES_DEFAULT, bool = false) noexcept override; // Restarts game(resets board and state)
-	void load_rules(std::istream&); // Loads the rules from given stream in text format
-	void save_rules(std::ostream&) const; // Outputs current rules to given stream in text format
-	void load_board(std::istream&); // Loads the board from given stream in text format
-	void save_board(std::ostream&) const; // Outputs current board to given stream in text format
-	void load_game(std::istream&); // Loads a game from given stream in text format
-	void save_game(std::ostream&) const; // Outputs current game to given stream in text format
-	// Returns score of the current game position(FOR WHITE AS MAXIMIZER)
-	inline int16_t score(void) const noexcept;
-	// Returns score of the current game position using quiescence search(FOR CURRENT TURN AS MAXIMIZER)
-	template<colour>
-	int16_t evaluate(int16_t, int16_t);
-protected:
-	// This function is only for using in step function(and company). It only sets specified cell, without updating other stuff
-	inline void _set_cell(int, int, Piece);
-	inline void _set_cell(Position, Piece);
-	// Initialization of piece-square tables
-	void init_psq(void);
-	// Sort move list according to move order scores
-	void score_moves(MoveList&, PseudoMove = { {0, 0}, {0, 0} }); // Explicit 0-Initialization(NOT {}) of PseudoMove is IMPORTANT!
-	// Update killer moves for given ply with given move
-	void update_killers(int16_t, PseudoMove);
-	// Overridden Board functions
-	inline void _put_piece(Position, Piece) override;
-	inline void _remove_piece(Position) override;
-	// Functions for writing and reading values from transposition tables(needed for ply-adjustment of mate scores)
-	static inline int16_t value_from_tt(const TT_Entry&, int16_t);
-	static inline int16_t value_to_tt(int16_t, int16_t);
-	// Misc
-	static inline bool _legal_position(Position) noexcept;
-	static inline int16_t lose_score(int16_t) noexcept;
-	static inline int16_t win_score(int16_t) noexcept;
-	inline int16_t no_moves_score(int16_t) const noexcept;
-	inline int piece_weight(piece_type) const noexcept;
-	inline int captured_weight(const Move&) const;
-	inline float _history_move_score(const Move&) const;
-	inline bool _history_greater(const Move&, const Move&) const;
-	inline void _update_possible_moves(void);
-	inline bool _endgame(void) const noexcept;
-	// Internal logic of AI(principal variation search)
-	template<colour, node_type>
-	int16_t _pvs(int8_t, int16_t, int16_t);
-	// Internal logic of AI
-	template<colour>
-	int8_t get_computer_move(Move&, int&);
-	// Members
-	float time_limit; // Time limit of search
-	int8_t search_depth; // Depth of search
-	int16_t _score; // Internal member for get_computer_move function(for storing results of recursive calls)
-	int16_t root_ply; // Game ply of the root of current search
-	int16_t inc_score; // Position score that is evaluated incrementally(for white as maximizer)
-	int time_check_counter; // Counter for checking time in AI
-	std::chrono::time_point<std::chrono::high_resolution_clock> start_time; // Start time of AI search
-	bool timeout; // Whether it's timeout when AI is thinking
-	bool in_search; // Whether we are in search now
-	std::vector<Move> undos; // Stack for information about undoing moves
-	std::stack<Move> redos; // Stack for information about redoing undone moves
-	Move _cur_move; // Internal member for step function
-	std::vector<Move> _cur_possible_moves; // Internal member for step function
-	TranspositionTable _transtable[2]; // Scores for some of already computed positions where 0 is white's turn and 1 is black's
-	SVector<std::list<PseudoMove>, 1024> killers; // Killers for killer heuristic in AI(indexed by ply)
-	Move countermove[64][64]; // Countermove table for countermove heuristic
-	int history[64][64]; // History table for relative history heuristic in AI
-	int butterfly[64][64]; // Butterfly table for relative history heuristic in AI
-};
-
-inline int8_t Checkers::get_search_depth(void) const noexcept
-{
-	return search_depth;
-}
-
-inline float Checkers::get_time_limit(void) const noexcept
-{
-	return time_limit;
-}
-
-inline const Move& Checkers::get_part_move(void) const noexcept
-{
-	return _cur_move;
-}
-
-inline size_t Checkers::get_part_move_size(void) const noexcept
-{
-	return _cur_move.size();
-}
-
-// Get all possible moves which begin with current inputed(by step function) part(if it's empty now, all possible moves are returned)
-inline const std::vector<Move>& Checkers::get_part_possible_moves(void) const
-{
-	return _cur_possible_moves;
-}
-
-inline const Move& Checkers::get_last_move(void) const
-{
-	return undos.back();
-}
-
-inline colour Checkers::current_turn_colour(void) const noexcept
-{
-	return white_turn ? WHITE : BLACK;
-}
-
-inline const Piece* Checkers::operator[](size_t idx) const
-{
-	return board[idx];
-}
-
-// Set search depth. Should be [1; MAX_SEARCH_DEPTH]
-inline void Checkers::set_search_depth(int8_t depth) noexcept
-{
-	if (depth == UNBOUNDED_DEPTH)
-		search_depth = depth;
-	else
-		search_depth = std::max<int8_t>(depth, 1);
-}
-
-inline void Checkers::set_time_limit(float limit) noexcept
-{
-	time_limit = limit;
-}
-
-// Updates currently possible moves
-inline void Checkers::_update_possible_moves(void)
-{
-	_cur_possible_moves.clear();
-	get_all_moves(_cur_possible_moves);
-}
-
-inline void Checkers::_set_cell(int row, int col, Piece piece)
-{
-	board[row][col] = piece;
-}
-
-inline void Checkers::_set_cell(Position pos, Piece piece)
-{
-	board[pos.get_row()][pos.get_column()] = piece;
-}
-
-inline int16_t Checkers::value_from_tt(const TT_Entry& entry, int16_t ply)
-{
-	return
-		entry.value < MAX_LOSE_SCORE ? entry.value + ply :
-		entry.value > MIN_WIN_SCORE ? entry.value - ply :
-		entry.value;
-}
-
-inline int16_t Checkers::value_to_tt(int16_t value, int16_t ply)
-{
-	return
-		value < MAX_LOSE_SCORE ? value - ply :
-		value > MIN_WIN_SCORE ? value + ply :
-		value;
-}
-
-inline int Checkers::piece_weight(piece_type pt) const noexcept
-{
-	static constexpr int pw[PT_COUNT] = { 0, 0, NORMAL_WEIGHT, NORMAL_WEIGHT,
-		0, 0, QUEEN_WEIGHT, QUEEN_WEIGHT };
-	static constexpr int pw_eg[PT_COUNT] = { 0, 0, NORMAL_WEIGHT_ENDGAME, NORMAL_WEIGHT_ENDGAME,
-		0, 0, QUEEN_WEIGHT_ENDGAME, QUEEN_WEIGHT_ENDGAME };
-	return _endgame() ? pw[pt] : pw_eg[pt];
-}
-
-inline bool Checkers::_endgame(void) const noexcept
-{
-	return all_piece_count < 10;
-}
-
-// Score for maximizer, if it loses(parameter is current ply)
-inline int16_t Checkers::lose_score(int16_t ply) noexcept
-{
-	return -MAX_SCORE + ply;
-}
-
-// Score for maximizer, if it is winning(parameter is current ply)
-inline int16_t Checkers::win_score(int16_t ply) noexcept
-{
-	return MAX_SCORE - ply;
-}
-
-inline int16_t Checkers::no_moves_score(int16_t ply) const noexcept
-{
-	return get_misere() ? win_score(ply) : lose_score(ply);
-}
-
-inline float Checkers::_history_move_score(const Move& m) const
-{
-	return (float)(history[pos_idx(m.old_pos())][pos_idx(m.new_pos())]) /
-		butterfly[pos_idx(m.old_pos())][pos_idx(m.new_pos())];
-}
-
-inline bool Checkers::_history_greater(const Move& lhs, const Move& rhs) const
-{
-	return
-		history[pos_idx(lhs.old_pos())][pos_idx(lhs.new_pos())] * butterfly[pos_idx(rhs.old_pos())][pos_idx(rhs.new_pos())] >
-		history[pos_idx(rhs.old_pos())][pos_idx(rhs.new_pos())] * butterfly[pos_idx(lhs.old_pos())][pos_idx(lhs.new_pos())];
-}
-
-inline int Checkers::captured_weight(const Move& move) const
-{
-	int ret(0);
-	for (const auto& capt : move.get_captured())
-		ret += piece_weight(capt.second.get_type());
-	return ret;
-}
-
-// Returns whether given position is valid
-inline bool Checkers::_legal_position(Position pos) noexcept
-{
-	return pos.get_row() > 0 && pos.get_column() > 0 && pos.get_row() < 8 && pos.get_column() < 8 &&
-		(pos.get_row() & 1) == (pos.get_column() & 1);
-}
-
-inline int8_t Checkers::get_computer_move(Move& m, int& sc)
-{
-	if (white_turn)
-		return get_computer_move<WHITE>(m, sc);
-	else
-		return get_computer_move<BLACK>(m, sc);
-}
-
-inline int8_t Checkers::get_computer_move(Move& out)
-{
-	int tmp;
-	return get_computer_move(out, tmp);
-}
-
+/*
+========================================================================
+Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// checkers.h, version 1.8
+
+#pragma once
+#ifndef _CHECKERS_H
+#define _CHECKERS_H
+#include <iostream>
+#include <vector>
+#include <list>
+#include <stack>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <atomic>
+#include <functional>
+#include "misc.h"
+#include "board.h"
+#include "tt.h"
+#include "bitbase.h"
+#include "book.h"
+#include "analysis_store.h"
+#include "nnue.h"
+#include "eval_params.h"
+#include "search_params.h"
+#include "pdn.h"
+
+#define TIMEOUT_CHECK_ON true
+
+enum step_result : int8_t { STEP_ILLEGAL, STEP_ILLEGAL_NEW, STEP_PROCEED, STEP_FINISH };
+enum node_type : int8_t { NODE_PV, NODE_CUT, NODE_ALL };
+
+// Progress of search, which is reported after each finished iteration of iterative deepening
+struct SearchInfo
+{
+	int8_t depth; // Depth of finished iteration
+	int16_t score; // Score for side to move
+	uint64_t nodes; // Count of nodes visited so far
+	float time; // Time elapsed since the start of search, ms
+	Move best_move; // Best move found so far
+};
+
+// Expected node type of child of node with given expected type in a null-window search
+constexpr inline node_type nw_child(node_type node) noexcept
+{
+	return node == NODE_CUT ? NODE_ALL : NODE_CUT;
+}
+
+class Checkers
+	: public Board
+{
+public:
+	static constexpr int TIME_CHECK_INTERVAL = 10000; // Interval(in number of calls to _pvs) between checking for timeout
+	static constexpr int16_t MAX_SCORE = 25000; // Max score(absolute value), which indicates special situations(win/loss, initial value etc)
+	static constexpr int16_t MAX_LOSE_SCORE = -MAX_SCORE + 1000; // Maximum score for loosing player
+	static constexpr int16_t MIN_WIN_SCORE = MAX_SCORE - 1000; // Minimum score for winning player
+	static constexpr int16_t BITBASE_WIN_SCORE = MIN_WIN_SCORE - 4000; // Base score of position which is won according to the bitbase
+	static constexpr int MAX_KILLERS = 3; // Maximum numbers of killers for killer heuristic(AI)
+	static constexpr int MS_TT_MOVE = 1000000000; // Move order score for move from the transposition table
+	static constexpr int MS_KILLER_MOVE = 1000000; // Move order score for killer move
+	static constexpr int MS_COUNTERMOVE_BONUS = 1000; // Move order bonus for countermoves
+	static constexpr int STORE_MAX_PLY = 2; // Maximum distance from the root where analysis store is used in _pvs
+	static constexpr int8_t STORE_TRUSTED_DEPTH = 16; // Minimum depth of stored result played without search if depth is unbounded
+	static constexpr float DEFAULT_TIME_LIMIT = 5000.0f; // Maximum thinking time, ms
+	static constexpr int8_t UNBOUNDED_DEPTH = -1; // search_depth value indicating absence of search depth bound
+#if defined _DEBUG || defined DEBUG
+	static constexpr int8_t MAX_SEARCH_DEPTH = 20; // Maximum search depth of AI
+#else
+	static constexpr int8_t MAX_SEARCH_DEPTH = 120; // Maximum search depth of AI
+#endif
+	// Constructor
+	Checkers(game_rules = RULES_DEFAULT, bool = false) noexcept;
+	// Destructor
+	~Checkers(void) noexcept;
+	// Public member functions
+	inline int8_t get_search_depth(void) const noexcept;
+	inline float get_time_limit(void) const noexcept;
+	inline uint64_t get_node_limit(void) const noexcept;
+	inline uint64_t get_nodes(void) const noexcept; // Count of nodes visited by the last search
+	inline const Move& get_part_move(void) const noexcept;
+	inline size_t get_part_move_size(void) const noexcept;
+	inline const std::vector<Move>& get_part_possible_moves(void) const;
+	inline const Move& get_last_move(void) const;
+	inline colour current_turn_colour(void) const noexcept;
+	inline const Piece* operator[](size_t) const;
+	inline void set_search_depth(int8_t) noexcept;
+	inline void set_time_limit(float) noexcept;
+	inline void set_node_limit(uint64_t) noexcept;
+	inline void set_bitbase(const Bitbase*) noexcept;
+	inline void set_book(const OpeningBook*) noexcept;
+	inline void set_analysis_store(AnalysisStore*) noexcept;
+	void set_network(const NNUE*) noexcept;
+	inline const EvalParams& get_eval_params(void) const noexcept;
+	void set_eval_params(const EvalParams&) noexcept;
+	inline const SearchParams& get_search_params(void) const noexcept;
+	inline void set_search_params(const SearchParams&) noexcept;
+	// Sets function which receives progress of search. It is called from the thread that runs the search,
+	// while the board is at the root position (so get_pv can be used in it)
+	inline void set_info_callback(std::function<void(const SearchInfo&)>);
+	inline size_t get_hash_size(void) const noexcept; // Size of transposition tables in megabytes
+	void set_hash_size(size_t); // Resizes transposition tables to fit given count of megabytes (they are cleared)
+	inline void request_stop(void) noexcept; // Stops current search like a timeout (can be called from other threads)
+	inline void reset_stop(void) noexcept; // Clears stop request. Should be done before search that may be stopped
+	// Outputs principal variation of current position (from transposition table) of at most given length
+	void get_pv(std::vector<Move>&, int);
+	bool move(Move&); // Function for inputing player's move
+	// Function for inputing player's move step-by-step. Returns
+	// STEP_ILLEGAL and discards information about move if the move is illegal,
+	// STEP_ILLEGAL_NEW if the move is illegal, but given position is a start for new(valid) move
+	// STEP_PROCEED if given step is valid(there is legal move beginning with inputted step sequence),
+	// STEP_FINISH if given step is valid and the whole move is finished
+	step_result step(const Position&);
+	// AI. Outputs computer's move to a first parameter and position score to a second.
+	// Returns search depth of the last iterative deepening iteration. Uses minimax algorithm with alpha-beta pruning
+	inline int8_t get_computer_move(Move&, int&);
+	inline int8_t get_computer_move(Move&);
+	void part_undo(void); // Undoing of current unfinished part move(inputted with step function)
+	void undo_move(void); // Undo last move
+	void redo_move(void); // Redo last undone move
+	void perform_computer_move(void); // AI. Performs computer move
+	void restart(game_rules = RULES_DEFAULT, bool = false) noexcept override; // Restarts game(resets board and state)
+	void set_game(game_rules, bool, const std::vector<Move>&); // Sets up a game from the initial position with given moves
+	void load_rules(std::istream&); // Loads the rules from given stream in text format
+	void save_rules(std::ostream&) const; // Outputs current rules to given stream in text format
+	bool set_fen(const char*, const char*) override; // Sets up position given by position string
+	void load_board(std::istream&); // Loads the board from given stream in text format or position string
+	void save_board(std::ostream&) const; // Outputs current board to given stream in text format
+	void load_game(std::istream&); // Loads the first game from given stream in text format or PDN
+	void save_game(std::ostream&) const; // Outputs current game to given stream in text format
+	void load_pdn(const PdnGame&); // Sets up given game read by PdnReader
+	// Outputs current game to given stream in PDN with given tags
+	void save_pdn(std::ostream&, const std::vector<std::pair<std::string, std::string>>& = {}) const;
+	// Returns score of the current game position(FOR WHITE AS MAXIMIZER)
+	inline int16_t score(void) const noexcept;
+	// Returns static score of the current game position, which is given by the network if it suits current rules
+	template<colour>
+	inline int16_t static_score(void) const noexcept;
+	// Returns score of the current game position using quiescence search(FOR CURRENT TURN AS MAXIMIZER)
+	template<colour>
+	int16_t evaluate(int16_t, int16_t);
+protected:
+	// This function is only for using in step function(and company). It only sets specified cell, without updating other stuff
+	inline void _set_cell(int, int, Piece);
+	inline void _set_cell(Position, Piece);
+	// Sort move list according to move order scores
+	void score_moves(MoveList&, PseudoMove = { {0, 0}, {0, 0} }); // Explicit 0-Initialization(NOT {}) of PseudoMove is IMPORTANT!
+	// Update killer moves for given ply with given move
+	void update_killers(int16_t, PseudoMove);
+	// Overridden Board functions
+	void _put_piece(Position, Piece) override;
+	void _remove_piece(Position) override;
+	void _clear_board(void) override;
+	// Functions for writing and reading values from transposition tables(needed for ply-adjustment of mate scores)
+	static inline int16_t value_from_tt(const TT_Entry&, int16_t);
+	static inline int16_t value_from_tt(int16_t, int16_t);
+	static inline int16_t value_to_tt(int16_t, int16_t);
+	// Misc
+	static inline bool _legal_position(Position) noexcept;
+	static inline int16_t lose_score(int16_t) noexcept;
+	static inline int16_t win_score(int16_t) noexcept;
+	inline int16_t no_moves_score(int16_t) const noexcept;
+	inline int piece_weight(piece_type) const noexcept;
+	inline int captured_weight(const Move&) const;
+	inline float _history_move_score(const Move&) const;
+	inline bool _history_greater(const Move&, const Move&) const;
+	inline void _update_possible_moves(void);
+	inline bool _endgame(void) const noexcept;
+	template<colour>
+	inline void _prefetch_child(const Move&) const noexcept;
+	void _restart(game_rules, bool) noexcept; // Restarts game without clearing transposition tables
+	// Internal logic of AI(principal variation search)
+	template<colour, node_type>
+	int16_t _pvs(int8_t, int16_t, int16_t);
+	// Internal logic of AI
+	template<colour>
+	int8_t get_computer_move(Move&, int&);
+	template<colour>
+	void _get_pv(std::vector<Move>&, int);
+	// Members
+	float time_limit; // Time limit of search
+	int8_t search_depth; // Depth of search
+	int16_t _score; // Internal member for get_computer_move function(for storing results of recursive calls)
+	int16_t root_ply; // Game ply of the root of current search
+	int16_t inc_score; // Position score that is evaluated incrementally(for white as maximizer)
+	int time_check_counter; // Counter for checking time in AI
+	uint64_t nodes; // Count of nodes visited by current(or the last) search
+	uint64_t node_limit; // Maximum count of nodes per search(0 if unlimited)
+	std::chrono::time_point<std::chrono::high_resolution_clock> start_time; // Start time of AI search
+	bool timeout; // Whether it's timeout when AI is thinking
+	bool in_search; // Whether we are in search now
+	std::atomic<bool> stop_requested; // Whether current search should be stopped as soon as possible
+	std::function<void(const SearchInfo&)> info_callback; // Receiver of search progress (may be empty)
+	const Bitbase* bitbase[GAME_RULES_COUNT]; // Win/draw/loss bitbases for each rules (nullptr if absent)
+	const OpeningBook* book[GAME_RULES_COUNT]; // Opening books for each rules (nullptr if absent)
+	std::minstd_rand book_rng; // Generator for choosing among book moves
+	AnalysisStore* store; // Persistent store of search results (nullptr if absent)
+	const NNUE* network; // Neural network evaluation (nullptr if absent)
+	NNUEAccumulator accumulator; // Network's first layer outputs that are updated incrementally(like inc_score)
+	EvalParams eval_params; // Parameters of handcrafted evaluation
+	SearchParams search_params; // Parameters of search
+	std::vector<Move> undos; // Stack for information about undoing moves
+	std::stack<Move> redos; // Stack for information about redoing undone moves
+	Move _cur_move; // Internal member for step function
+	std::vector<Move> _cur_possible_moves; // Internal member for step function
+	TranspositionTable _transtable[2]; // Scores for some of already computed positions where 0 is white's turn and 1 is black's
+	SVector<std::list<PseudoMove>, 1024> killers; // Killers for killer heuristic in AI(indexed by ply)
+	Move countermove[64][64]; // Countermove table for countermove heuristic
+	int history[64][64]; // History table for relative history heuristic in AI
+	int butterfly[64][64]; // Butterfly table for relative history heuristic in AI
+};
+
+inline int8_t Checkers::get_search_depth(void) const noexcept
+{
+	return search_depth;
+}
+
+inline float Checkers::get_time_limit(void) const noexcept
+{
+	return time_limit;
+}
+
+inline uint64_t Checkers::get_node_limit(void) const noexcept
+{
+	return node_limit;
+}
+
+inline uint64_t Checkers::get_nodes(void) const noexcept
+{
+	return nodes;
+}
+
+inline const Move& Checkers::get_part_move(void) const noexcept
+{
+	return _cur_move;
+}
+
+inline size_t Checkers::get_part_move_size(void) const noexcept
+{
+	return _cur_move.size();
+}
+
+// Get all possible moves which begin with current inputed(by step function) part(if it's empty now, all possible moves are returned)
+inline const std::vector<Move>& Checkers::get_part_possible_moves(void) const
+{
+	return _cur_possible_moves;
+}
+
+inline const Move& Checkers::get_last_move(void) const
+{
+	return undos.back();
+}
+
+inline colour Checkers::current_turn_colour(void) const noexcept
+{
+	return white_turn ? WHITE : BLACK;
+}
+
+inline const Piece* Checkers::operator[](size_t idx) const
+{
+	return board[idx];
+}
+
+// Set search depth. Should be [1; MAX_SEARCH_DEPTH]
+inline void Checkers::set_search_depth(int8_t depth) noexcept
+{
+	if (depth == UNBOUNDED_DEPTH)
+		search_depth = depth;
+	else
+		search_depth = std::max<int8_t>(depth, 1);
+}
+
+inline void Checkers::set_time_limit(float limit) noexcept
+{
+	time_limit = limit;
+}
+
+// Set maximum count of nodes per search(0 means no limit). Search stops like on timeout when it is reached
+inline void Checkers::set_node_limit(uint64_t limit) noexcept
+{
+	node_limit = limit;
+}
+
+// Set bitbase which is used for rules it was generated for. It should be loaded and outlive this object
+inline void Checkers::set_bitbase(const Bitbase* bb) noexcept
+{
+	if (bb != nullptr && bb->is_loaded())
+		bitbase[bb->get_rules()] = bb;
+}
+
+// Set opening book which is used for rules it was built for. It should be open and outlive this object
+inline void Checkers::set_book(const OpeningBook* bk) noexcept
+{
+	if (bk != nullptr && bk->is_open())
+		book[bk->get_rules()] = bk;
+}
+
+inline const EvalParams& Checkers::get_eval_params(void) const noexcept
+{
+	return eval_params;
+}
+
+inline const SearchParams& Checkers::get_search_params(void) const noexcept
+{
+	return search_params;
+}
+
+inline void Checkers::set_search_params(const SearchParams& params) noexcept
+{
+	search_params = params;
+}
+
+inline void Checkers::set_info_callback(std::function<void(const SearchInfo&)> callback)
+{
+	info_callback = std::move(callback);
+}
+
+inline size_t Checkers::get_hash_size(void) const noexcept
+{
+	return (_transtable[0].get_size() + _transtable[1].get_size()) * sizeof(TT_Bucket) >> 20;
+}
+
+inline void Checkers::request_stop(void) noexcept
+{
+	stop_requested = true;
+}
+
+inline void Checkers::reset_stop(void) noexcept
+{
+	stop_requested = false;
+}
+
+// Set persistent analysis store which is consulted and updated by search (nullptr disables it)
+inline void Checkers::set_analysis_store(AnalysisStore* st) noexcept
+{
+	store = st;
+}
+
+// Updates currently possible moves
+inline void Checkers::_update_possible_moves(void)
+{
+	_cur_possible_moves.clear();
+	get_all_moves(_cur_possible_moves);
+}
+
+inline void Checkers::_set_cell(int row, int col, Piece piece)
+{
+	board[row][col] = piece;
+}
+
+inline void Checkers::_set_cell(Position pos, Piece piece)
+{
+	board[pos.get_row()][pos.get_column()] = piece;
+}
+
+inline int16_t Checkers::value_from_tt(const TT_Entry& entry, int16_t ply)
+{
+	return value_from_tt(entry.value, ply);
+}
+
+inline int16_t Checkers::value_from_tt(int16_t value, int16_t ply)
+{
+	return
+		value < MAX_LOSE_SCORE ? value + ply :
+		value > MIN_WIN_SCORE ? value - ply :
+		value;
+}
+
+inline int16_t Checkers::value_to_tt(int16_t value, int16_t ply)
+{
+	return
+		value < MAX_LOSE_SCORE ? value - ply :
+		value > MIN_WIN_SCORE ? value + ply :
+		value;
+}
+
+inline int Checkers::piece_weight(piece_type pt) const noexcept
+{
+	if (pt == PT_EMPTY || pt == PT_SHADOW)
+		return 0;
+	if (_endgame())
+		return eval_params.value[is_queen(pt) ? EP_QUEEN_WEIGHT_ENDGAME : EP_NORMAL_WEIGHT_ENDGAME];
+	return eval_params.value[is_queen(pt) ? EP_QUEEN_WEIGHT : EP_NORMAL_WEIGHT];
+}
+
+inline int16_t Checkers::score(void) const noexcept
+{
+	// Immediately set sc to piece-square table's score
+	int16_t sc(inc_score), normal_weight, queen_weight;
+	// Adjust weights of normal and queen pieces in current game phase
+	if (_endgame())
+		normal_weight = eval_params.value[EP_NORMAL_WEIGHT_ENDGAME], queen_weight = eval_params.value[EP_QUEEN_WEIGHT_ENDGAME];
+	else
+		normal_weight = eval_params.value[EP_NORMAL_WEIGHT], queen_weight = eval_params.value[EP_QUEEN_WEIGHT];
+	// Material score
+	const int white_weight = normal_weight*piece_count[WHITE_SIMPLE]
+		+ queen_weight*piece_count[WHITE_QUEEN];
+	const int black_weight = normal_weight*piece_count[BLACK_SIMPLE]
+		+ queen_weight*piece_count[BLACK_QUEEN];
+	sc += white_weight - black_weight;
+	// Relative material advantage (for that reason it is good to exchange if we have material advantage)
+	sc += eval_params.value[EP_RELMAT_MULT] * (white_weight - black_weight) / (white_weight + black_weight);
+	// Return score according to whether we play misere or normal game
+	return get_misere() ? -sc : sc;
+}
+
+template<colour TURN>
+inline int16_t Checkers::static_score(void) const noexcept
+{
+	if (network != nullptr && network->get_rules() == rules && network->get_misere() == misere)
+		return network->evaluate(accumulator, TURN);
+	// Take care of sign because score() is computed for white as maximizer
+	return TURN == WHITE ? score() : -score();
+}
+
+inline bool Checkers::_endgame(void) const noexcept
+{
+	return all_piece_count < 10;
+}
+
+// Starts loading transposition table bucket of position after given move of TURN, so that the child's
+// probe doesn't wait for memory (should be called only for children which probe the table, i.e. not leaves)
+template<colour TURN>
+inline void Checkers::_prefetch_child(const Move& move) const noexcept
+{
+	_transtable[opposite(TURN) - WHITE].prefetch(child_hash(move));
+}
+
+// Score for maximizer, if it loses(parameter is current ply)
+inline int16_t Checkers::lose_score(int16_t ply) noexcept
+{
+	return -MAX_SCORE + ply;
+}
+
+// Score for maximizer, if it is winning(parameter is current ply)
+inline int16_t Checkers::win_score(int16_t ply) noexcept
+{
+	return MAX_SCORE - ply;
+}
+
+inline int16_t Checkers::no_moves_score(int16_t ply) const noexcept
+{
+	return get_misere() ? win_score(ply) : lose_score(ply);
+}
+
+inline float Checkers::_history_move_score(const Move& m) const
+{
+	return (float)(history[pos_idx(m.old_pos())][pos_idx(m.new_pos())]) /
+		butterfly[pos_idx(m.old_pos())][pos_idx(m.new_pos())];
+}
+
+inline bool Checkers::_history_greater(const Move& lhs, const Move& rhs) const
+{
+	return
+		history[pos_idx(lhs.old_pos())][pos_idx(lhs.new_pos())] * butterfly[pos_idx(rhs.old_pos())][pos_idx(rhs.new_pos())] >
+		history[pos_idx(rhs.old_pos())][pos_idx(rhs.new_pos())] * butterfly[pos_idx(lhs.old_pos())][pos_idx(lhs.new_pos())];
+}
+
+inline int Checkers::captured_weight(const Move& move) const
+{
+	int ret(0);
+	for (const auto& capt : move.get_captured())
+		ret += piece_weight(capt.second.get_type());
+	return ret;
+}
+
+// Returns whether given position is valid
+inline bool Checkers::_legal_position(Position pos) noexcept
+{
+	return pos.get_row() > 0 && pos.get_column() > 0 && pos.get_row() < 8 && pos.get_column() < 8 &&
+		(pos.get_row() & 1) == (pos.get_column() & 1);
+}
+
+inline int8_t Checkers::get_computer_move(Move& m, int& sc)
+{
+	if (white_turn)
+		return get_computer_move<WHITE>(m, sc);
+	else
+		return get_computer_move<BLACK>(m, sc);
+}
+
+inline int8_t Checkers::get_computer_move(Move& out)
+{
+	int tmp;
+	return get_computer_move(out, tmp);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// eval_params.cpp, version 1.8
+
+#include "eval_params.h"
+#include "misc.h"
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace
+{
+	constexpr int16_t DEFAULT_VALUES[EVAL_PARAM_COUNT] = {
+		100, // EP_NORMAL_WEIGHT
+		280, // EP_QUEEN_WEIGHT
+		105, // EP_NORMAL_WEIGHT_ENDGAME
+		325, // EP_QUEEN_WEIGHT_ENDGAME
+		275, // EP_RELMAT_MULT
+		// EP_SIMPLE_PSQ (the last row is unused, since simple pieces are promoted there)
+		  0,   1,   3,   5,
+		  3,   4,   5,   8,
+		  6,   7,   9,  12,
+		 12,  12,  14,  14,
+		 14,  16,  16,  17,
+		 18,  20,  21,  21,
+		 23,  24,  25,  25,
+		 -1,  -1,  -1,  -1,
+		// EP_QUEEN_PSQ
+		-15, -10, -10, -10,
+		-10,   5,   0,   0,
+		-10,   0,   5,   0,
+		-10,   0,   0,  10,
+		-10,   0,   0,  10,
+		-10,   0,   5,   0,
+		-10,   5,   0,   0,
+		-15, -10, -10, -10
+	};
+	// Names of scalar parameters and tables in text format
+	const char* const SCALAR_NAMES[EP_SIMPLE_PSQ] = { "normal_weight", "queen_weight",
+		"normal_weight_endgame", "queen_weight_endgame", "relmat_mult" };
+	const char* const SIMPLE_PSQ_NAME = "simple_psq";
+	const char* const QUEEN_PSQ_NAME = "queen_psq";
+	// Default parameters with expanded tables
+	constexpr EvalParams DEFAULT_PARAMS(DEFAULT_VALUES);
+}
+
+EvalParams::EvalParams(void) noexcept
+{
+	*this = DEFAULT_PARAMS;
+}
+
+void EvalParams::load(const std::string& file_name)
+{
+	std::ifstream in(file_name);
+	if (!in)
+		throw(checkers_error("Unable to open evaluation parameters file " + file_name));
+	load(in);
+}
+
+void EvalParams::load(std::istream& istr)
+{
+	EvalParams loaded;
+	std::string name;
+	while (istr >> name)
+	{
+		int first, count;
+		if (name == SIMPLE_PSQ_NAME)
+			first = EP_SIMPLE_PSQ, count = 32;
+		else if (name == QUEEN_PSQ_NAME)
+			first = EP_QUEEN_PSQ, count = 32;
+		else
+		{
+			first = int(std::find(SCALAR_NAMES, SCALAR_NAMES + EP_SIMPLE_PSQ, name) - SCALAR_NAMES);
+			count = 1;
+			if (first == EP_SIMPLE_PSQ)
+				throw(checkers_error("Unknown evaluation parameter " + name));
+		}
+		for (int i = first; i < first + count; ++i)
+			if (!(istr >> loaded.value[i]))
+				throw(checkers_error("Wrong value of evaluation parameter " + name));
+	}
+	loaded.expand();
+	*this = loaded;
+}
+
+void EvalParams::save(const std::string& file_name) const
+{
+	std::ofstream out(file_name);
+	if (!out)
+		throw(checkers_error("Unable to create evaluation parameters file " + file_name));
+	save(out);
+}
+
+void EvalParams::save(std::ostream& ostr) const
+{
+	for (int i = 0; i < EP_SIMPLE_PSQ; ++i)
+		ostr << SCALAR_NAMES[i] << ' ' << value[i] << '\n';
+	const std::pair<const char*, int> tables[2] = { { SIMPLE_PSQ_NAME, EP_SIMPLE_PSQ }, { QUEEN_PSQ_NAME, EP_QUEEN_PSQ } };
+	for (const auto& table : tables)
+	{
+		ostr << table.first << '\n';
+		for (int row = 0; row < 8; ++row)
+		{
+			for (int i = 0; i < 4; ++i)
+				ostr << std::setw(5) << value[table.second + (row << 2) + i];
+			ostr << '\n';
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// eval_params.h, version 1.8
+
+#pragma once
+#ifndef _EVAL_PARAMS_H
+#define _EVAL_PARAMS_H
+#include <string>
+#include <iostream>
+#include "piece.h"
+#include "position.h"
+
+// Indices of handcrafted evaluation parameters. Piece-square parameters are given for the left half of
+// each row of white's tables, the right half is mirrored (so each row's playable squares get distinct
+// parameters) and black's tables are vertically mirrored white's ones
+enum eval_param : int {
+	EP_NORMAL_WEIGHT, // Weight of non-queen piece
+	EP_QUEEN_WEIGHT, // Weight of queen piece
+	EP_NORMAL_WEIGHT_ENDGAME, // Weight of non-queen piece in endgame
+	EP_QUEEN_WEIGHT_ENDGAME, // Weight of queen piece in endgame
+	EP_RELMAT_MULT, // Multiplier for relative material advantage
+	EP_SIMPLE_PSQ, // Piece-square table of white non-queen piece (8 rows of 4 values)
+	EP_QUEEN_PSQ = EP_SIMPLE_PSQ + 32, // Piece-square table of white queen (8 rows of 4 values)
+	EVAL_PARAM_COUNT = EP_QUEEN_PSQ + 32
+};
+
+// Parameter set of handcrafted evaluation, which can be loaded at runtime (e.g. after tuning)
+struct EvalParams
+{
+	int16_t value[EVAL_PARAM_COUNT]; // Parameter values
+	int16_t psq[PT_COUNT][8][8]; // Full piece-square tables (expanded from parameter values)
+	// Constructor. Sets default parameters (they are expanded at compile time)
+	EvalParams(void) noexcept;
+	// Constructor. Sets given parameter values
+	constexpr EvalParams(const int16_t(&)[EVAL_PARAM_COUNT]) noexcept;
+	// Expands piece-square parameters to full tables. Should be called after changing values
+	constexpr void expand(void) noexcept;
+	// Returns index of parameter which gives full table's value for given piece type and position.
+	// Sign of its contribution is output to the last parameter
+	static constexpr inline int psq_param(piece_type, Position, int&) noexcept;
+	void load(const std::string&); // Loads parameters from given file
+	void load(std::istream&); // Loads parameters from given stream in text format
+	void save(const std::string&) const; // Saves parameters to given file
+	void save(std::ostream&) const; // Outputs parameters to given stream in text format
+};
+
+constexpr EvalParams::EvalParams(const int16_t(&values)[EVAL_PARAM_COUNT]) noexcept
+	: value(), psq()
+{
+	for (int i = 0; i < EVAL_PARAM_COUNT; ++i)
+		value[i] = values[i];
+	expand();
+}
+
+constexpr void EvalParams::expand(void) noexcept
+{
+	const piece_type types[4] = { WHITE_SIMPLE, BLACK_SIMPLE, WHITE_QUEEN, BLACK_QUEEN };
+	for (int pt = 0; pt < PT_COUNT; ++pt)
+		for (int row = 0; row < 8; ++row)
+			for (int column = 0; column < 8; ++column)
+				psq[pt][row][column] = 0;
+	for (int t = 0; t < 4; ++t)
+		for (int row = 0; row < 8; ++row)
+			for (int column = 0; column < 8; ++column)
+			{
+				int sign = 0;
+				const int param = psq_param(types[t], Position(row, column), sign);
+				psq[types[t]][row][column] = int16_t(sign * value[param]);
+			}
+}
+
+constexpr inline int EvalParams::psq_param(piece_type pt, Position pos, int& sign) noexcept
+{
+	const int row = (get_colour(pt) == WHITE ? pos.get_row() : 7 - pos.get_row());
+	const int column = (pos.get_column() < 4 ? pos.get_column() : 7 - pos.get_column());
+	sign = (get_colour(pt) == WHITE ? 1 : -1);
+	return (is_queen(pt) ? EP_QUEEN_PSQ : EP_SIMPLE_PSQ) + (row << 2) + column;
+}
+
+#endif
\ No newline at end of file
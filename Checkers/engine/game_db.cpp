@@ -0,0 +1,324 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// game_db.cpp, version 1.8
+
+#include "game_db.h"
+#include "misc.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+	constexpr char DB_MAGIC[8] = { 'C', 'H', 'K', 'R', 'S', 'G', 'D', '1' };
+	constexpr char INDEX_MAGIC[8] = { 'C', 'H', 'K', 'R', 'S', 'G', 'I', '1' };
+	const std::string INDEX_SUFFIX = ".idx";
+	// Header is padded to entry size so that entries stay aligned in the mapped file
+	struct IndexHeader
+	{
+		char magic[8];
+		uint64_t game_count; // Count of games covered by the index
+	};
+	static_assert(sizeof(IndexHeader) == sizeof(GameIndexEntry), "Index header should have size of an entry");
+
+	// Order of moves in the database (by their paths)
+	bool path_less(const MLNode& lhs, const MLNode& rhs) noexcept
+	{
+		const Move& a = lhs.move;
+		const Move& b = rhs.move;
+		for (int i = 0; i < a.size() && i < b.size(); ++i)
+			if (a[i] != b[i])
+				return pos_idx(a[i]) < pos_idx(b[i]);
+		return a.size() < b.size();
+	}
+
+	inline game_rules record_rules(const GameRecord& record) noexcept
+	{
+		return (record.flags & GameRecord::GRF_ENGLISH) ? RULES_ENGLISH : RULES_DEFAULT;
+	}
+
+	inline bool record_misere(const GameRecord& record) noexcept
+	{
+		return (record.flags & GameRecord::GRF_MISERE) != 0;
+	}
+}
+
+// Board which replays games of the database
+class DatabaseReplay
+	: public Board
+{
+public:
+	using Board::Board;
+	// Outputs legal moves in the order of database
+	void get_sorted_moves(MoveList& moves) const
+	{
+		moves.clear();
+		get_all_moves(moves);
+		std::stable_sort(moves.begin(), moves.end(), path_less);
+	}
+	void play(Move& move)
+	{
+		_do_move(move);
+		_proceed(move);
+		_update_game_state();
+	}
+};
+
+GameDatabaseWriter::GameDatabaseWriter(const std::string& file_name)
+	: count(0)
+{
+	std::ifstream existing(file_name, std::ios::binary);
+	const bool has_header = (existing && existing.peek() != std::ifstream::traits_type::eof());
+	existing.close();
+	out.open(file_name, std::ios::binary | std::ios::app);
+	if (!out)
+		throw(checkers_error("Unable to create game database file " + file_name));
+	if (!has_header)
+		out.write(DB_MAGIC, sizeof(DB_MAGIC));
+}
+
+GameDatabaseWriter::~GameDatabaseWriter(void) noexcept = default;
+
+// Matcher returns index of the ply's move in sorted legal moves (or -1 if there is no such move)
+template<typename Matcher>
+bool GameDatabaseWriter::_add_game(game_rules rule, bool mis, size_t ply_count, Matcher match, game_state result)
+{
+	if (ply_count > std::numeric_limits<uint16_t>::max())
+		return false;
+	DatabaseReplay replay(rule);
+	replay.restart(rule, mis);
+	MoveList legal;
+	buffer.resize(sizeof(GameRecord));
+	for (size_t ply = 0; ply < ply_count; ++ply)
+	{
+		if (replay.get_state() != GAME_CONTINUE)
+			return false;
+		replay.get_sorted_moves(legal);
+		const int idx = match(ply, legal);
+		if (idx < 0)
+			return false;
+		buffer.push_back(uint8_t(idx));
+		replay.play(legal[idx].move);
+	}
+	if (result == GAME_CONTINUE)
+		result = replay.get_state();
+	const GameRecord record{ uint16_t(ply_count), uint8_t((rule == RULES_ENGLISH ? GameRecord::GRF_ENGLISH : 0)
+		| (mis ? GameRecord::GRF_MISERE : 0)), int8_t(result) };
+	std::memcpy(buffer.data(), &record, sizeof(record));
+	out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	if (!out)
+		throw(checkers_error("Unable to write game database"));
+	++count;
+	return true;
+}
+
+bool GameDatabaseWriter::add_game(game_rules rule, bool mis, const std::vector<Move>& moves, game_state result)
+{
+	return _add_game(rule, mis, moves.size(), [&moves](size_t ply, const MoveList& legal) {
+		for (int i = 0; i < legal.size(); ++i)
+			if (legal[i].move == moves[ply])
+				return i;
+		return -1;
+	}, result);
+}
+
+bool GameDatabaseWriter::add_game(const PdnGame& game)
+{
+	return _add_game(game.rules, game.misere, game.moves.size(), [&game](size_t ply, const MoveList& legal) {
+		int found = -1;
+		for (int i = 0; i < legal.size(); ++i)
+			if (game.moves[ply].matches(legal[i].move))
+			{
+				if (found != -1)
+					return -1; // Ambiguous move
+				found = i;
+			}
+		return found;
+	}, game.result);
+}
+
+GameDatabase::GameDatabase(void) noexcept
+	: index(nullptr), index_size(0), indexed_count(0)
+{}
+
+GameDatabase::~GameDatabase(void) noexcept = default;
+
+void GameDatabase::open(const std::string& name)
+{
+	close();
+	file.open(name);
+	if (file.size() < sizeof(DB_MAGIC) || std::memcmp(file.data(), DB_MAGIC, sizeof(DB_MAGIC)) != 0)
+	{
+		file.close();
+		throw(checkers_error("Game database has wrong format"));
+	}
+	file_name = name;
+	// Find game records. The last one may be incomplete if writing was interrupted
+	GameRecord record;
+	for (uint64_t offset = sizeof(DB_MAGIC); offset + sizeof(record) <= file.size(); )
+	{
+		std::memcpy(&record, file.data() + offset, sizeof(record));
+		const uint64_t next = offset + sizeof(record) + record.ply_count;
+		if (next > file.size())
+			break;
+		offsets.push_back(offset);
+		offset = next;
+	}
+	if (std::ifstream(file_name + INDEX_SUFFIX))
+		_open_index();
+}
+
+void GameDatabase::_open_index(void)
+{
+	index_file.open(file_name + INDEX_SUFFIX);
+	IndexHeader header;
+	if (index_file.size() < sizeof(header) || (index_file.size() - sizeof(header)) % sizeof(GameIndexEntry) != 0)
+	{
+		index_file.close();
+		throw(checkers_error("Game database index has wrong size"));
+	}
+	std::memcpy(&header, index_file.data(), sizeof(header));
+	if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || header.game_count > size())
+	{
+		index_file.close();
+		throw(checkers_error("Game database index doesn't match the database"));
+	}
+	// Games which were appended after building the index aren't covered by it
+	indexed_count = size_t(header.game_count);
+	index = reinterpret_cast<const GameIndexEntry*>(index_file.data() + sizeof(header));
+	index_size = (index_file.size() - sizeof(header)) / sizeof(GameIndexEntry);
+}
+
+void GameDatabase::close(void) noexcept
+{
+	file.close();
+	index_file.close();
+	offsets.clear();
+	index = nullptr;
+	index_size = indexed_count = 0;
+}
+
+void GameDatabase::get_game(size_t game, game_rules& rule, bool& mis, std::vector<Move>& moves) const
+{
+	const GameRecord record = get_record(game);
+	const uint8_t* move_idx = reinterpret_cast<const uint8_t*>(file.data() + offsets[game] + sizeof(record));
+	rule = record_rules(record);
+	mis = record_misere(record);
+	moves.clear();
+	DatabaseReplay replay(rule);
+	replay.restart(rule, mis);
+	MoveList legal;
+	for (int ply = 0; ply < record.ply_count; ++ply)
+	{
+		replay.get_sorted_moves(legal);
+		if (replay.get_state() != GAME_CONTINUE || move_idx[ply] >= legal.size())
+			throw(checkers_error("Game " + std::to_string(game) + " of the database is corrupted"));
+		moves.push_back(legal[move_idx[ply]].move);
+		replay.play(moves.back());
+	}
+}
+
+void GameDatabase::build_index(int max_ply)
+{
+	std::vector<GameIndexEntry> entries;
+	DatabaseReplay replay;
+	MoveList legal;
+	for (size_t game = 0; game < size(); ++game)
+	{
+		const GameRecord record = get_record(game);
+		const uint8_t* move_idx = reinterpret_cast<const uint8_t*>(file.data() + offsets[game] + sizeof(record));
+		replay.restart(record_rules(record), record_misere(record));
+		for (int ply = 0; ply <= std::min<int>(record.ply_count, max_ply); ++ply)
+		{
+			const bool last = (ply == record.ply_count);
+			entries.push_back({ replay.get_full_hash(), uint32_t(game), uint16_t(ply),
+				last ? GameIndexEntry::NO_MOVE : move_idx[ply], record.result });
+			if (last)
+				break;
+			replay.get_sorted_moves(legal);
+			if (replay.get_state() != GAME_CONTINUE || move_idx[ply] >= legal.size())
+				throw(checkers_error("Game " + std::to_string(game) + " of the database is corrupted"));
+			replay.play(legal[move_idx[ply]].move);
+		}
+	}
+	std::sort(entries.begin(), entries.end(), [](const GameIndexEntry& lhs, const GameIndexEntry& rhs) {
+		return lhs.key < rhs.key || (lhs.key == rhs.key && (lhs.game < rhs.game
+			|| (lhs.game == rhs.game && lhs.ply < rhs.ply)));
+	});
+	// The old index is unmapped before it is overwritten
+	index_file.close();
+	index = nullptr;
+	index_size = indexed_count = 0;
+	{
+		std::ofstream out(file_name + INDEX_SUFFIX, std::ios::binary | std::ios::trunc);
+		IndexHeader header = {};
+		std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+		header.game_count = size();
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(GameIndexEntry));
+		if (!out)
+			throw(checkers_error("Unable to write game database index " + file_name + INDEX_SUFFIX));
+	}
+	_open_index();
+}
+
+size_t GameDatabase::find(uint64_t key, const GameIndexEntry*& first) const noexcept
+{
+	const auto range = std::equal_range(index, index + index_size, GameIndexEntry{ key, 0, 0, 0, 0 },
+		[](const GameIndexEntry& lhs, const GameIndexEntry& rhs) { return lhs.key < rhs.key; });
+	first = range.first;
+	return range.second - range.first;
+}
+
+void GameDatabase::get_stats(const Board& board, std::vector<MoveStats>& stats) const
+{
+	stats.clear();
+	const GameIndexEntry* first;
+	const size_t count = find(board.get_full_hash(), first);
+	if (count == 0)
+		return;
+	// Moves of entries are indices of sorted legal moves of the position
+	MoveList legal;
+	board.get_all_moves(legal);
+	std::stable_sort(legal.begin(), legal.end(), path_less);
+	std::vector<int> stat_idx(legal.size(), -1);
+	const game_state win = (board.get_white_turn() ? WHITE_WIN : BLACK_WIN);
+	const game_state loss = (board.get_white_turn() ? BLACK_WIN : WHITE_WIN);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const GameIndexEntry& entry = first[i];
+		if (entry.move >= legal.size()) // End of the game (or hash collision)
+			continue;
+		if (stat_idx[entry.move] == -1)
+		{
+			stat_idx[entry.move] = int(stats.size());
+			stats.push_back({ legal[entry.move].move, 0, 0, 0, 0 });
+		}
+		MoveStats& cur = stats[stat_idx[entry.move]];
+		++cur.games;
+		cur.wins += (entry.result == win);
+		cur.draws += (entry.result == DRAW);
+		cur.losses += (entry.result == loss);
+	}
+	std::stable_sort(stats.begin(), stats.end(), [](const MoveStats& lhs, const MoveStats& rhs) {
+		return lhs.games > rhs.games;
+	});
+}
\ No newline at end of file
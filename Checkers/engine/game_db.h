@@ -0,0 +1,165 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// game_db.h, version 1.8
+
+#pragma once
+#ifndef _GAME_DB_H
+#define _GAME_DB_H
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include "board.h"
+#include "mapped_file.h"
+#include "pdn.h"
+
+// Header of a game in binary game database. It is followed by a byte per ply, which is index of the played move
+// in the list of legal moves sorted by path (so the index depends only on the position, not on move generation)
+struct GameRecord
+{
+	uint16_t ply_count;
+	uint8_t flags; // GRF_* flags
+	int8_t result; // Game result (game_state, GAME_CONTINUE for unfinished games)
+
+	static constexpr uint8_t GRF_ENGLISH = 1; // Game is played by english rules
+	static constexpr uint8_t GRF_MISERE = 2; // Game is misere
+};
+
+static_assert(sizeof(GameRecord) == 4, "Game record header should be 4 bytes");
+
+// Entry of position index of game database. Entries are sorted by key and then by game and ply
+struct GameIndexEntry
+{
+	uint64_t key; // Full hash of position (see Board::get_full_hash)
+	uint32_t game; // Index of the game
+	uint16_t ply; // Ply at which the position occured
+	uint8_t move; // Index of the move played there (NO_MOVE at the end of the game)
+	int8_t result; // Result of the game
+
+	static constexpr uint8_t NO_MOVE = 0xff;
+};
+
+static_assert(sizeof(GameIndexEntry) == 16, "Game index entry should be 16 bytes");
+
+// Statistics of a move in some position over games of the database (results are for side to move)
+struct MoveStats
+{
+	Move move;
+	uint32_t games;
+	uint32_t wins;
+	uint32_t draws;
+	uint32_t losses;
+};
+
+// Appends games to binary game database file (creating it if needed)
+class GameDatabaseWriter
+{
+public:
+	// Constructor. Opens given file for appending
+	GameDatabaseWriter(const std::string&);
+	// Destructor
+	~GameDatabaseWriter(void) noexcept;
+	// Public member functions
+	inline uint64_t get_count(void) const noexcept; // Count of games written by this writer
+	// Appends game with given rules, moves (from the initial position) and result (by default it is the state
+	// after the last move). Returns false (and writes nothing) if the game contains an illegal move
+	bool add_game(game_rules, bool, const std::vector<Move>&, game_state = GAME_CONTINUE);
+	bool add_game(const PdnGame&); // Appends game read from PDN (its moves are matched with legal ones)
+private:
+	template<typename Matcher>
+	bool _add_game(game_rules, bool, size_t, Matcher, game_state);
+	std::ofstream out;
+	std::vector<uint8_t> buffer;
+	uint64_t count;
+};
+
+// Binary game database which is memory-mapped from a file, with optional position index (in file with
+// the name of database followed by .idx), which lets find games with a position without replaying them
+class GameDatabase
+{
+public:
+	// Constructor
+	GameDatabase(void) noexcept;
+	// Destructor
+	~GameDatabase(void) noexcept;
+	// Public member functions
+	inline bool is_open(void) const noexcept;
+	inline size_t size(void) const noexcept; // Count of games
+	inline bool has_index(void) const noexcept;
+	inline size_t get_indexed_count(void) const noexcept; // Count of games covered by the index
+	// Maps database from given file (an incomplete last game is ignored) together with its index if it exists
+	void open(const std::string&);
+	void close(void) noexcept; // Unmaps database and index
+	inline GameRecord get_record(size_t) const noexcept; // Header of game with given index
+	// Replays game with given index and outputs its rules, game type and moves
+	void get_game(size_t, game_rules&, bool&, std::vector<Move>&) const;
+	// Builds position index of the database (positions after given ply aren't indexed) and opens it
+	void build_index(int = INT16_MAX);
+	// Finds index entries of position with given full hash. Returns their count and sets given pointer to the first one
+	size_t find(uint64_t, const GameIndexEntry*&) const noexcept;
+	// Outputs statistics of moves played from board's current position (sorted by game count)
+	void get_stats(const Board&, std::vector<MoveStats>&) const;
+private:
+	void _open_index(void);
+	std::string file_name;
+	MappedFile file;
+	MappedFile index_file;
+	std::vector<uint64_t> offsets; // Offset of each game's record in the file
+	const GameIndexEntry* index; // Entries which start right after the index header
+	size_t index_size;
+	size_t indexed_count;
+};
+
+inline uint64_t GameDatabaseWriter::get_count(void) const noexcept
+{
+	return count;
+}
+
+inline bool GameDatabase::is_open(void) const noexcept
+{
+	return file.is_open();
+}
+
+inline size_t GameDatabase::size(void) const noexcept
+{
+	return offsets.size();
+}
+
+inline bool GameDatabase::has_index(void) const noexcept
+{
+	return index != nullptr;
+}
+
+inline size_t GameDatabase::get_indexed_count(void) const noexcept
+{
+	return indexed_count;
+}
+
+// Records aren't aligned in the file, so the header is copied
+inline GameRecord GameDatabase::get_record(size_t game) const noexcept
+{
+	GameRecord record;
+	std::memcpy(&record, file.data() + offsets[game], sizeof(record));
+	return record;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+
+// large_memory.cpp, version 1.8
+
+#include "large_memory.h"
+#include "misc.h"
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace
+{
+	constexpr size_t SMALL_PAGE_SIZE = 4096;
+	constexpr inline size_t round_up(size_t size, size_t unit) noexcept
+	{
+		return (size + unit - 1) / unit * unit;
+	}
+#ifdef _WIN32
+	// Minimal size of large page, or 0 if they can't be used (locking memory requires SeLockMemoryPrivilege
+	// which the user should have been granted, but it still has to be enabled for the process)
+	size_t large_page_size(void) noexcept
+	{
+		static const size_t size = []() -> size_t {
+			HANDLE token;
+			if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+				return 0;
+			TOKEN_PRIVILEGES privileges;
+			privileges.PrivilegeCount = 1;
+			privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+			// AdjustTokenPrivileges succeeds even if the privilege isn't held, so the error code is checked too
+			const bool enabled = LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid)
+				&& AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) && GetLastError() == ERROR_SUCCESS;
+			CloseHandle(token);
+			return enabled ? GetLargePageMinimum() : 0;
+		}();
+		return size;
+	}
+	// Processors of each NUMA node which has them
+	const std::vector<GROUP_AFFINITY>& node_processors(void)
+	{
+		static const std::vector<GROUP_AFFINITY> nodes = []() {
+			std::vector<GROUP_AFFINITY> result;
+			ULONG highest;
+			if (GetNumaHighestNodeNumber(&highest))
+				for (ULONG node = 0; node <= highest; ++node)
+				{
+					GROUP_AFFINITY affinity;
+					if (GetNumaNodeProcessorMaskEx(USHORT(node), &affinity) && affinity.Mask != 0)
+						result.push_back(affinity);
+				}
+			return result;
+		}();
+		return nodes;
+	}
+#else
+	constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20; // Usual size of huge page on x86-64 and aarch64
+#endif
+#ifdef __linux__
+	// Calls given function for each number of list like "0-3,8,10-11" which is read from given file
+	template<typename F>
+	void read_number_list(const std::string& file_name, F function)
+	{
+		std::ifstream in(file_name);
+		std::string range;
+		while (std::getline(in, range, ','))
+		{
+			std::istringstream range_in(range);
+			int first, last;
+			char dash;
+			if (!(range_in >> first))
+				break;
+			last = (range_in >> dash >> last && dash == '-' ? last : first);
+			for (int i = first; i <= last; ++i)
+				function(i);
+		}
+	}
+	// Processors of each NUMA node which has them
+	const std::vector<cpu_set_t>& node_processors(void)
+	{
+		static const std::vector<cpu_set_t> nodes = []() {
+			std::vector<cpu_set_t> result;
+			read_number_list("/sys/devices/system/node/online", [&result](int node) {
+				cpu_set_t processors;
+				bool any = false;
+				CPU_ZERO(&processors);
+				read_number_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist",
+					[&processors, &any](int cpu) {
+					if (cpu < CPU_SETSIZE)
+						CPU_SET(cpu, &processors), any = true;
+				});
+				if (any)
+					result.push_back(processors);
+			});
+			return result;
+		}();
+		return nodes;
+	}
+#endif
+}
+
+LargeMemory::LargeMemory(void) noexcept
+	: ptr(nullptr), block_size(0), mapped_size(0), large_pages(false)
+{}
+
+LargeMemory::~LargeMemory(void) noexcept
+{
+	release();
+}
+
+void LargeMemory::allocate(size_t size, bool spread)
+{
+	release();
+	if (size == 0)
+		return;
+#ifdef _WIN32
+	// Large pages are locked in physical memory, so they are tried only for blocks which span at least one
+	const size_t large_size = large_page_size();
+	if (large_size != 0 && size >= large_size)
+	{
+		mapped_size = round_up(size, large_size);
+		ptr = VirtualAlloc(nullptr, mapped_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		large_pages = (ptr != nullptr);
+	}
+	if (ptr == nullptr)
+	{
+		mapped_size = round_up(size, SMALL_PAGE_SIZE);
+		ptr = VirtualAlloc(nullptr, mapped_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+#else
+#ifdef MAP_HUGETLB
+	// Explicit huge pages are available only if the administrator has reserved them (vm.nr_hugepages)
+	if (size >= HUGE_PAGE_SIZE)
+	{
+		mapped_size = round_up(size, HUGE_PAGE_SIZE);
+		void* view = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (view != MAP_FAILED)
+			ptr = view, large_pages = true;
+	}
+#endif
+	if (ptr == nullptr && size >= HUGE_PAGE_SIZE)
+	{
+		// Map with a spare huge page and trim both ends, so that the block is aligned to huge page size
+		// and can be entirely backed by transparent huge pages
+		mapped_size = round_up(size, HUGE_PAGE_SIZE);
+		void* view = mmap(nullptr, mapped_size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (view != MAP_FAILED)
+		{
+			char* const begin = static_cast<char*>(view);
+			char* const aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(begin), HUGE_PAGE_SIZE));
+			if (aligned != begin)
+				munmap(begin, aligned - begin);
+			const size_t tail = begin + HUGE_PAGE_SIZE - aligned;
+			if (tail != 0)
+				munmap(aligned + mapped_size, tail);
+#ifdef MADV_HUGEPAGE
+			madvise(aligned, mapped_size, MADV_HUGEPAGE);
+#endif
+			ptr = aligned;
+		}
+	}
+	else if (ptr == nullptr)
+	{
+		mapped_size = round_up(size, SMALL_PAGE_SIZE);
+		void* view = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (view != MAP_FAILED)
+			ptr = view;
+	}
+#endif
+	if (ptr == nullptr)
+	{
+		mapped_size = 0;
+		throw(checkers_error("Unable to allocate " + std::to_string(size >> 20) + " MB of memory"));
+	}
+	block_size = size;
+	// Memory is zeroed by the system, but physical pages are placed on the node of the thread which touches
+	// them first (except for large pages on Windows, which are allocated at once)
+#ifdef _WIN32
+	spread = spread && !large_pages;
+#endif
+	const int nodes = numa_node_count();
+	if (spread && nodes > 1)
+	{
+		const size_t chunk = round_up((mapped_size + nodes - 1) / nodes, SMALL_PAGE_SIZE);
+		std::vector<std::thread> threads;
+		for (int node = 0; node < nodes; ++node)
+			threads.emplace_back([this, chunk, node]() {
+				bind_thread_to_node(node);
+				const size_t begin = std::min(chunk * node, mapped_size);
+				std::memset(static_cast<char*>(ptr) + begin, 0, std::min(chunk, mapped_size - begin));
+			});
+		for (auto& thread : threads)
+			thread.join();
+	}
+}
+
+void LargeMemory::release(void) noexcept
+{
+	if (ptr != nullptr)
+	{
+#ifdef _WIN32
+		VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+		munmap(ptr, mapped_size);
+#endif
+	}
+	ptr = nullptr;
+	block_size = mapped_size = 0;
+	large_pages = false;
+}
+
+int numa_node_count(void)
+{
+#if defined _WIN32 || defined __linux__
+	return std::max(int(node_processors().size()), 1);
+#else
+	return 1;
+#endif
+}
+
+void bind_thread_to_node(int index) noexcept
+{
+#if defined _WIN32 || defined __linux__
+	const auto& nodes = node_processors();
+	if (nodes.size() <= 1)
+		return;
+	const auto& processors = nodes[index % nodes.size()];
+#ifdef _WIN32
+	SetThreadGroupAffinity(GetCurrentThread(), &processors, nullptr);
+#else
+	pthread_setaffinity_np(pthread_self(), sizeof(processors), &processors);
+#endif
+#else
+	(void)index;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+
+// large_memory.h, version 1.8
+
+#pragma once
+#ifndef _LARGE_MEMORY_H
+#define _LARGE_MEMORY_H
+#include <cstddef>
+
+// Zero-initialised memory block for big randomly accessed tables (transposition tables, bitbases). It is backed
+// by large pages when the system provides them (which saves TLB misses), otherwise by ordinary pages which are
+// marked as candidates for transparent huge pages where it is supported
+class LargeMemory
+{
+public:
+	// Constructor
+	LargeMemory(void) noexcept;
+	LargeMemory(const LargeMemory&) = delete;
+	LargeMemory& operator=(const LargeMemory&) = delete;
+	// Destructor
+	~LargeMemory(void) noexcept;
+	// Public member functions
+	template<typename T>
+	inline T* as(void) const noexcept;
+	inline size_t size(void) const noexcept;
+	inline bool has_large_pages(void) const noexcept; // Whether the block is backed by explicit large pages
+	// Allocates block of given size in bytes (previous one is released). If the second argument is true, pages
+	// are first touched by threads bound to each NUMA node in turn, so that memory is spread across nodes
+	void allocate(size_t, bool = false);
+	void release(void) noexcept; // Releases the block
+private:
+	void* ptr;
+	size_t block_size; // Size requested by allocate
+	size_t mapped_size; // Size of the mapping (rounded up to page size)
+	bool large_pages;
+};
+
+int numa_node_count(void); // Count of NUMA nodes which have processors (1 if it can't be determined)
+// Binds current thread to processors of NUMA node with given index modulo node count (so that consecutive
+// workers are spread across nodes). Does nothing on systems with one node
+void bind_thread_to_node(int) noexcept;
+
+template<typename T>
+inline T* LargeMemory::as(void) const noexcept
+{
+	return static_cast<T*>(ptr);
+}
+
+inline size_t LargeMemory::size(void) const noexcept
+{
+	return block_size;
+}
+
+inline bool LargeMemory::has_large_pages(void) const noexcept
+{
+	return large_pages;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// mapped_file.cpp, version 1.8
+
+#include "mapped_file.h"
+#include "misc.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(void) noexcept
+	: ptr(nullptr), file_size(0), writable(false), file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr)
+{}
+#else
+MappedFile::MappedFile(void) noexcept
+	: ptr(nullptr), file_size(0), writable(false)
+{}
+#endif
+
+MappedFile::~MappedFile(void) noexcept
+{
+	close();
+}
+
+void MappedFile::open(const std::string& file_name, bool write)
+{
+	close();
+	writable = write;
+#ifdef _WIN32
+	file_handle = CreateFileA(file_name.c_str(), write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+		write ? FILE_SHARE_READ | FILE_SHARE_WRITE : FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER size;
+	if (file_handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_handle, &size))
+	{
+		close();
+		throw(checkers_error("Unable to open file " + file_name));
+	}
+	file_size = static_cast<size_t>(size.QuadPart);
+	if (file_size != 0)
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, write ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_handle != nullptr)
+		ptr = static_cast<char*>(MapViewOfFile(mapping_handle, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+#else
+	const int fd = ::open(file_name.c_str(), write ? O_RDWR : O_RDONLY);
+	struct stat st;
+	if (fd == -1 || fstat(fd, &st) != 0)
+	{
+		if (fd != -1)
+			::close(fd);
+		throw(checkers_error("Unable to open file " + file_name));
+	}
+	file_size = static_cast<size_t>(st.st_size);
+	void* view = (file_size == 0 ? MAP_FAILED : mmap(nullptr, file_size,
+		write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0));
+	::close(fd); // Mapping stays valid after closing the descriptor
+	if (view != MAP_FAILED)
+		ptr = static_cast<char*>(view);
+#endif
+	if (ptr == nullptr)
+	{
+		close();
+		throw(checkers_error("Unable to map file " + file_name + " (it may be empty)"));
+	}
+}
+
+void MappedFile::close(void) noexcept
+{
+#ifdef _WIN32
+	if (ptr != nullptr)
+		UnmapViewOfFile(ptr);
+	if (mapping_handle != nullptr)
+		CloseHandle(mapping_handle);
+	if (file_handle != INVALID_HANDLE_VALUE)
+		CloseHandle(file_handle);
+	mapping_handle = nullptr;
+	file_handle = INVALID_HANDLE_VALUE;
+#else
+	if (ptr != nullptr)
+		munmap(ptr, file_size);
+#endif
+	ptr = nullptr;
+	file_size = 0;
+	writable = false;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// mapped_file.h, version 1.8
+
+#pragma once
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Memory mapping of a whole file. Lets big data files (opening books etc.) be probed directly from
+// the page cache without loading them into process memory. Writable mappings are shared, so changes
+// are visible to all processes which map the same file and are eventually written back to it
+class MappedFile
+{
+public:
+	// Constructor
+	MappedFile(void) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	// Destructor
+	~MappedFile(void) noexcept;
+	// Public member functions
+	inline bool is_open(void) const noexcept;
+	inline bool is_writable(void) const noexcept;
+	inline const char* data(void) const noexcept;
+	inline char* data(void) noexcept; // Should be used only for writable mappings
+	inline size_t size(void) const noexcept;
+	void open(const std::string&, bool = false); // Maps given file, optionally writable (previously mapped one is closed)
+	void close(void) noexcept; // Unmaps the file
+private:
+	char* ptr; // Beginning of the mapped view
+	size_t file_size; // Size of the mapped view
+	bool writable; // Whether the view is writable
+#ifdef _WIN32
+	void* file_handle;
+	void* mapping_handle;
+#endif
+};
+
+inline bool MappedFile::is_open(void) const noexcept
+{
+	return ptr != nullptr;
+}
+
+inline bool MappedFile::is_writable(void) const noexcept
+{
+	return writable;
+}
+
+inline const char* MappedFile::data(void) const noexcept
+{
+	return ptr;
+}
+
+inline char* MappedFile::data(void) noexcept
+{
+	return ptr;
+}
+
+inline size_t MappedFile::size(void) const noexcept
+{
+	return file_size;
+}
+
+#endif
\ No newline at end of file
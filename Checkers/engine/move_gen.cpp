@@ -1,355 +1,512 @@
-/*
-========================================================================
-Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
-
-This file is part of Checkers source code
-
-Checkers is free software : you can redistribute it and / or modify
-it under the terms of the GNU General Public License as published by
-the Free Software Foundation, either version 3 of the License, or
-(at your option) any later version.
-
-Checkers is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with Checkers.If not, see <http://www.gnu.org/licenses/>
-========================================================================
-*/
-
-// move_gen.cpp, version 1.7
-
-#include "move_gen.h"
-#include "board.h"
-#include "misc.h"
-
-template<colour TURN, move_type MT>
-void MoveGenDefault::_get_all_moves(MoveList& moves) const
-{
-	static bool capture[8][8] = {};
-	// Search for capture-moves first
-	if (MT != NON_CAPTURE)
-	{
-		for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
-		{
-			const auto& pos = board.piece_list[turn_simple(TURN)][i];
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			tmp_assign<Piece> move_begin(const_cast<Piece&>
-				(board[pos.row][pos.column]), Piece(PT_EMPTY)); // Because this position is empty when we move from it
-			_find_deep_capture<TURN>(moves, move, pos.row, pos.column, capture);
-		}
-		for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
-		{
-			const auto& pos = board.piece_list[turn_queen(TURN)][i];
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			tmp_assign<Piece> move_begin(const_cast<Piece&>
-				(board[pos.row][pos.column]), Piece(PT_EMPTY)); // Because this position is empty when we move from it
-			_find_deep_capture_queen<TURN>(moves, move, pos.row, pos.column, capture);
-		}
-	}
-	// Capture-move is mandatory, so we need to check non-capture moves only when we don't have any capture-moves
-	if (MT == CAPTURE || !moves.empty())
-		return;
-	for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
-	{
-		const auto& pos = board.piece_list[turn_simple(TURN)][i];
-		if (pos.column < 7 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column + 1].get_type() == PT_EMPTY)
-		{
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			if (TURN == WHITE)
-			{
-				move.add_step(Position(pos.row + 1, pos.column + 1));
-				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
-			}
-			else
-			{
-				move.add_step(Position(pos.row - 1, pos.column + 1));
-				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
-			}
-			moves.emplace(std::move(move));
-		}
-		if (pos.column > 0 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column - 1].get_type() == PT_EMPTY)
-		{
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			if (TURN == WHITE)
-			{
-				move.add_step(Position(pos.row + 1, pos.column - 1));
-				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
-			}
-			else
-			{
-				move.add_step(Position(pos.row - 1, pos.column - 1));
-				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
-			}
-			moves.emplace(std::move(move));
-		}
-	}
-	for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
-	{
-		const auto& pos = board.piece_list[turn_queen(TURN)][i];
-		constexpr int dx[4] = { 1, 1, -1, -1 }, dy[4] = { 1, -1, 1, -1 };
-		for (size_t dir = 0; dir < 4; ++dir)
-			for (int r = pos.row + dy[dir], c = pos.column + dx[dir]; r < 8 && c < 8 && r >= 0 && c >= 0
-				&& board[r][c].get_type() == PT_EMPTY; r += dy[dir], c += dx[dir])
-			{
-				Move move(pos);
-				move.add_step(Position(r, c));
-				move.set_original(board[pos.row][pos.column]);
-				move.set_become(TURN == WHITE ? Piece(WHITE_QUEEN) : Piece(BLACK_QUEEN));
-				moves.emplace(std::move(move));
-			}
-	}
-}
-
-template<colour TURN>
-void MoveGenDefault::_find_deep_capture(MoveList& moves, Move& move, int8_t row, int8_t column, bool(&captured)[8][8]) const
-{
-	static constexpr int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
-	for (size_t dir = 0; dir < 4; ++dir)
-	{
-		const int r1 = row + d_row[dir], c1 = column + d_column[dir], r2 = r1 + d_row[dir], c2 = c1 + d_column[dir];
-		if (r2 < 0 || c2 < 0 || r2 > 7 || c2 > 7 || board[r2][c2].get_type() != PT_EMPTY
-			|| board[r1][c1].get_colour() != opposite(TURN) || captured[r1][c1])
-			continue;
-		move.add_step(Position(r2, c2)); // Correct capture-move
-		move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
-		const int old = moves.size();
-		captured[r1][c1] = true; // For preventing 'recapturing' piece at (r1; c1) in moves produced by recursive call to this function(next 4 lines)
-		if (TURN == WHITE ? (r2 == 7) : (r2 == 0)) // We can become queen at this move
-		{
-			_find_deep_capture_queen<TURN>(moves, move, r2, c2, captured);
-			if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
-			{
-				move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN));
-				moves.emplace(move);
-			}
-		}
-		else
-		{
-			_find_deep_capture<TURN>(moves, move, r2, c2, captured);
-			if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
-			{
-				move.set_become(Piece(TURN == WHITE ? WHITE_SIMPLE : BLACK_SIMPLE));
-				moves.emplace(move);
-			}
-		}
-		captured[r1][c1] = false; // For correct work on next cycles we should clear changes to 'captured' and 'move' variables
-		move.pop_step();
-		move.pop_capture();
-	}
-}
-
-template<colour TURN>
-void MoveGenDefault::_find_deep_capture_queen(MoveList& moves, Move& move, int8_t row, int8_t column, bool(&captured)[8][8]) const
-{
-	static constexpr int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
-	for (size_t dir = 0; dir < 4; ++dir)
-	{
-		bool capture_found = false;
-		int r1 = row + d_row[dir], c1 = column + d_column[dir];
-		for (; r1 < 7 && c1 < 7 && r1 > 0 && c1 > 0 && board[r1][c1].get_colour() != TURN &&
-			!captured[r1][c1]; r1 += d_row[dir], c1 += d_column[dir])
-			if (board[r1][c1].get_colour() == opposite(TURN))
-			{
-				capture_found = true;
-				break;
-			}
-		if (!capture_found)
-			continue;
-		captured[r1][c1] = true;
-		const int old = moves.size();
-		for (int r2 = r1 + d_row[dir], c2 = c1 + d_column[dir]; r2 < 8 && c2 < 8 && r2 >= 0 && c2 >= 0 &&
-			board[r2][c2].get_type() == PT_EMPTY; r2 += d_row[dir], c2 += d_column[dir])
-		{
-			move.add_step(Position(r2, c2));
-			move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
-			_find_deep_capture_queen<TURN>(moves, move, r2, c2, captured);
-			move.pop_step();
-			move.pop_capture();
-		}
-		if (old == moves.size()) // If in recursive calls we haven't found any move, then any move is a final capture in this direction and is one of possible captures
-			for (int r2 = r1 + d_row[dir], c2 = c1 + d_column[dir]; r2 < 8 && c2 < 8 && r2 >= 0 && c2 >= 0 &&
-				board[r2][c2].get_type() == PT_EMPTY; r2 += d_row[dir], c2 += d_column[dir])
-			{
-				move.add_step(Position(r2, c2));
-				move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
-				move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN));
-				moves.emplace(move);
-				move.pop_step();
-				move.pop_capture();
-			}
-		captured[r1][c1] = false;
-	}
-}
-
-template<colour TURN, move_type MT>
-void MoveGenEnglish::_get_all_moves(MoveList& moves) const
-{
-	static bool capture[8][8] = {};
-	// Search for capture-moves first
-	if (MT != NON_CAPTURE)
-	{
-		for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
-		{
-			const auto& pos = board.piece_list[turn_simple(TURN)][i];
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			_find_deep_capture<TURN>(moves, move, pos.row, pos.column);
-		}
-		for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
-		{
-			const auto& pos = board.piece_list[turn_queen(TURN)][i];
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			tmp_assign<Piece> move_begin(const_cast<Piece&>
-				(board[pos.row][pos.column]), Piece(PT_EMPTY)); // Because this position is empty when we move from it
-			_find_deep_capture_queen<TURN>(moves, move, pos.row, pos.column, capture);
-		}
-	}
-	// Capture-move is mandatory, so we need to check non-capture moves only when we don't have any capture-moves
-	if (MT == CAPTURE || !moves.empty())
-		return;
-	for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
-	{
-		const auto& pos = board.piece_list[turn_simple(TURN)][i];
-		if (pos.column < 7 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column + 1].get_type() == PT_EMPTY)
-		{
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			if (TURN == WHITE)
-			{
-				move.add_step(Position(pos.row + 1, pos.column + 1));
-				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
-			}
-			else
-			{
-				move.add_step(Position(pos.row - 1, pos.column + 1));
-				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
-			}
-			moves.emplace(std::move(move));
-		}
-		if (pos.column > 0 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column - 1].get_type() == PT_EMPTY)
-		{
-			Move move(pos);
-			move.set_original(board[pos.row][pos.column]);
-			if (TURN == WHITE)
-			{
-				move.add_step(Position(pos.row + 1, pos.column - 1));
-				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
-			}
-			else
-			{
-				move.add_step(Position(pos.row - 1, pos.column - 1));
-				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
-			}
-			moves.emplace(std::move(move));
-		}
-	}
-	for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
-	{
-		const auto& pos = board.piece_list[turn_queen(TURN)][i];
-		constexpr int dx[4] = { 1, 1, -1, -1 }, dy[4] = { 1, -1, 1, -1 };
-		for (size_t dir = 0; dir < 4; ++dir)
-		{
-			const int r = pos.row + dy[dir], c = pos.column + dx[dir]; // In english ckeckers queen moves only 1 square in each direction
-			if (r < 8 && c < 8 && r >= 0 && c >= 0 && board[r][c].get_type() == PT_EMPTY)
-			{
-				Move move(pos);
-				move.add_step(Position(r, c));
-				move.set_original(board[pos.row][pos.column]);
-				move.set_become(TURN == WHITE ? Piece(WHITE_QUEEN) : Piece(BLACK_QUEEN));
-				moves.emplace(std::move(move));
-			}
-		}
-	}
-}
-
-template<colour TURN>
-void MoveGenEnglish::_find_deep_capture(MoveList& moves, Move& move, int8_t row, int8_t column) const
-{
-	static constexpr int d_row = (TURN == WHITE ? 1 : -1), d_column[2] = { 1, -1 };
-	const int r1 = row + d_row, r2 = r1 + d_row;
-	if (r2 < 0 || r2 > 7)
-		return;
-	for (size_t dir = 0; dir < 2; ++dir)
-	{
-		const int c1 = column + d_column[dir], c2 = c1 + d_column[dir];
-		if (c2 < 0 || c2 > 7 || board[r2][c2].get_type() != PT_EMPTY
-			|| board[r1][c1].get_colour() != opposite(TURN))
-			continue;
-		move.add_step(Position(r2, c2)); // Correct capture-move
-		move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
-		const size_t old = moves.size();
-		if (TURN == WHITE ? (r2 == 7) : (r2 == 0)) // We can become queen at this move
-		{
-			move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN)); // In english checkers move is stopped when piece becomes queen
-			moves.emplace(move);
-		}
-		else
-		{
-			_find_deep_capture<TURN>(moves, move, r2, c2);
-			if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
-			{
-				move.set_become(Piece(TURN == WHITE ? WHITE_SIMPLE : BLACK_SIMPLE));
-				moves.emplace(move);
-			}
-		}
-		move.pop_step();
-		move.pop_capture();
-	}
-}
-
-template<colour TURN>
-void MoveGenEnglish::_find_deep_capture_queen(MoveList& moves, Move& move, int8_t row, int8_t column, bool(&captured)[8][8]) const
-{
-	static constexpr int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
-	for (size_t dir = 0; dir < 4; ++dir)
-	{
-		// In english checkers we can jump only over adjacent pieces
-		const int r1 = row + d_row[dir], c1 = column + d_column[dir], r2 = r1 + d_row[dir], c2 = c1 + d_column[dir];
-		if (r2 < 0 || c2 < 0 || r2 > 7 || c2 > 7 || board[r2][c2].get_type() != PT_EMPTY
-			|| board[r1][c1].get_colour() != opposite(TURN) || captured[r1][c1])
-			continue;
-		move.add_step(Position(r2, c2)); // Correct capture-move
-		move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
-		const size_t old = moves.size();
-		captured[r1][c1] = true; // For preventing 'recapturing' piece at (r1; c1) in moves produced by recursive call to this function(next 4 lines)
-		_find_deep_capture_queen<TURN>(moves, move, r2, c2, captured);
-		if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
-		{
-			move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN));
-			moves.emplace(move);
-		}
-		captured[r1][c1] = false; // For correct work on next cycles we should clear changes to 'captured' and 'move' variables
-		move.pop_step();
-		move.pop_capture();
-	}
-}
-
-// Explicit template instantiations
-template void	MoveGenDefault::_find_deep_capture<WHITE>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-template void	MoveGenDefault::_find_deep_capture<BLACK>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-template void	MoveGenDefault::_find_deep_capture_queen<WHITE>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-template void	MoveGenDefault::_find_deep_capture_queen<BLACK>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-template void	MoveGenDefault::_get_all_moves<WHITE, ALL>(MoveList&) const;
-template void	MoveGenDefault::_get_all_moves<WHITE, CAPTURE>(MoveList&) const;
-template void	MoveGenDefault::_get_all_moves<WHITE, NON_CAPTURE>(MoveList&) const;
-template void	MoveGenDefault::_get_all_moves<BLACK, ALL>(MoveList&) const;
-template void	MoveGenDefault::_get_all_moves<BLACK, CAPTURE>(MoveList&) const;
-template void	MoveGenDefault::_get_all_moves<BLACK, NON_CAPTURE>(MoveList&) const;
-template void	MoveGenEnglish::_find_deep_capture<WHITE>(MoveList&, Move&, int8_t, int8_t) const;
-template void	MoveGenEnglish::_find_deep_capture<BLACK>(MoveList&, Move&, int8_t, int8_t) const;
-template void	MoveGenEnglish::_find_deep_capture_queen<WHITE>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-template void	MoveGenEnglish::_find_deep_capture_queen<BLACK>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-template void	MoveGenEnglish::_get_all_moves<WHITE, ALL>(MoveList&) const;
-template void	MoveGenEnglish::_get_all_moves<WHITE, CAPTURE>(MoveList&) const;
-template void	MoveGenEnglish::_get_all_moves<WHITE, NON_CAPTURE>(MoveList&) const;
-template void	MoveGenEnglish::_get_all_moves<BLACK, ALL>(MoveList&) const;
-template void	MoveGenEnglish::_get_all_moves<BLACK, CAPTURE>(MoveList&) const;
-template void	MoveGenEnglish::_get_all_moves<BLACK, NON_CAPTURE>(MoveList&) const;
\ No newline at end of file
+/*
+========================================================================
+Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// move_gen.cpp, version 1.8
+
+#include "move_gen.h"
+#include "board.h"
+#include "misc.h"
+
+namespace
+{
+	// Squares of every diagonal ray (ordered from its origin) for each square and direction, so that
+	// flying kings walk diagonals without bounds checks. Directions are in order of d_row and d_column
+	// arrays of move generators. All squares of a ray except the last one are inner ones
+	struct DiagonalRays
+	{
+		int8_t length[8][8][4];
+		int8_t row[8][8][4][7];
+		int8_t column[8][8][4][7];
+		constexpr DiagonalRays(void)
+			: length(), row(), column()
+		{
+			const int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
+			for (int r = 0; r < 8; ++r)
+				for (int c = 0; c < 8; ++c)
+					for (int dir = 0; dir < 4; ++dir)
+						for (int r1 = r + d_row[dir], c1 = c + d_column[dir]; r1 >= 0 && c1 >= 0 && r1 < 8 && c1 < 8;
+							r1 += d_row[dir], c1 += d_column[dir])
+						{
+							row[r][c][dir][length[r][c][dir]] = r1;
+							column[r][c][dir][length[r][c][dir]++] = c1;
+						}
+		}
+	};
+
+	constexpr DiagonalRays DIAGONAL_RAYS;
+}
+
+void remove_equivalent_captures(MoveList& moves) noexcept
+{
+	// Lists of generators contain either only captures or only non-captures
+	if (moves.size() < 2 || moves[0].move.capt_size() == 0)
+		return;
+	uint64_t captured_mask[MAX_MOVES_COUNT]; // Captured squares of kept moves
+	int kept = 0;
+	for (int i = 0; i < moves.size(); ++i)
+	{
+		const Move& move = moves[i].move;
+		uint64_t mask = 0;
+		for (const auto& capture : move.get_captured())
+			mask |= uint64_t(1) << (capture.first.get_row() * 8 + capture.first.get_column());
+		bool equivalent = false;
+		for (int j = 0; j < kept && !equivalent; ++j)
+			equivalent = (captured_mask[j] == mask && moves[j].move.old_pos() == move.old_pos()
+				&& moves[j].move.new_pos() == move.new_pos() && moves[j].move.get_become() == move.get_become());
+		if (equivalent)
+			continue;
+		captured_mask[kept] = mask;
+		if (kept != i)
+			moves[kept] = moves[i];
+		++kept;
+	}
+	moves.resize(kept);
+}
+
+template<colour TURN>
+bool MoveGen::_has_non_capture(void) const
+{
+	static constexpr int d_row[4] = { TURN == WHITE ? 1 : -1, TURN == WHITE ? 1 : -1,
+		TURN == WHITE ? -1 : 1, TURN == WHITE ? -1 : 1 }, d_column[4] = { 1, -1, 1, -1 };
+	// Simple pieces move only forward, and they are never at their promotion row
+	for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
+	{
+		const Position pos = board.piece_list[turn_simple(TURN)][i];
+		const int row = pos.get_row(), column = pos.get_column();
+		for (size_t dir = 0; dir < 2; ++dir)
+		{
+			const int c = column + d_column[dir];
+			if (c >= 0 && c <= 7 && board[row + d_row[dir]][c].get_type() == PT_EMPTY)
+				return true;
+		}
+	}
+	for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
+	{
+		const Position pos = board.piece_list[turn_queen(TURN)][i];
+		const int row = pos.get_row(), column = pos.get_column();
+		for (size_t dir = 0; dir < 4; ++dir)
+		{
+			const int r = row + d_row[dir], c = column + d_column[dir];
+			if (r >= 0 && c >= 0 && r <= 7 && c <= 7 && board[r][c].get_type() == PT_EMPTY)
+				return true;
+		}
+	}
+	return false;
+}
+
+template<colour TURN, move_type MT>
+void MoveGenDefault::_get_all_moves(MoveList& moves) const
+{
+	bool capture[8][8] = {}; // Local, so that move generation is safe for concurrent boards
+	// Search for capture-moves first
+	if (MT != NON_CAPTURE)
+	{
+		for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
+		{
+			const auto& pos = board.piece_list[turn_simple(TURN)][i];
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			tmp_assign<Piece> move_begin(const_cast<Piece&>
+				(board[pos.row][pos.column]), Piece(PT_EMPTY)); // Because this position is empty when we move from it
+			_find_deep_capture<TURN>(moves, move, pos.row, pos.column, capture);
+		}
+		for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
+		{
+			const auto& pos = board.piece_list[turn_queen(TURN)][i];
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			tmp_assign<Piece> move_begin(const_cast<Piece&>
+				(board[pos.row][pos.column]), Piece(PT_EMPTY)); // Because this position is empty when we move from it
+			_find_deep_capture_queen<TURN>(moves, move, pos.row, pos.column, capture);
+		}
+	}
+	// Capture-move is mandatory, so we need to check non-capture moves only when we don't have any capture-moves
+	if (MT == CAPTURE || !moves.empty())
+		return;
+	for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
+	{
+		const auto& pos = board.piece_list[turn_simple(TURN)][i];
+		if (pos.column < 7 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column + 1].get_type() == PT_EMPTY)
+		{
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			if (TURN == WHITE)
+			{
+				move.add_step(Position(pos.row + 1, pos.column + 1));
+				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
+			}
+			else
+			{
+				move.add_step(Position(pos.row - 1, pos.column + 1));
+				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
+			}
+			moves.emplace(std::move(move));
+		}
+		if (pos.column > 0 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column - 1].get_type() == PT_EMPTY)
+		{
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			if (TURN == WHITE)
+			{
+				move.add_step(Position(pos.row + 1, pos.column - 1));
+				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
+			}
+			else
+			{
+				move.add_step(Position(pos.row - 1, pos.column - 1));
+				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
+			}
+			moves.emplace(std::move(move));
+		}
+	}
+	for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
+	{
+		const auto& pos = board.piece_list[turn_queen(TURN)][i];
+		// Moves are generated by diagonals in order of (1, 1), (-1, 1), (1, -1) and (-1, -1) row and column
+		// steps (it determines order of equally scored moves after sorting)
+		for (const int dir : { 0, 2, 1, 3 })
+		{
+			const int8_t* const ray_row = DIAGONAL_RAYS.row[pos.row][pos.column][dir];
+			const int8_t* const ray_column = DIAGONAL_RAYS.column[pos.row][pos.column][dir];
+			for (int k = 0; k < DIAGONAL_RAYS.length[pos.row][pos.column][dir]
+				&& board[ray_row[k]][ray_column[k]].get_type() == PT_EMPTY; ++k)
+			{
+				Move move(pos);
+				move.add_step(Position(ray_row[k], ray_column[k]));
+				move.set_original(board[pos.row][pos.column]);
+				move.set_become(TURN == WHITE ? Piece(WHITE_QUEEN) : Piece(BLACK_QUEEN));
+				moves.emplace(std::move(move));
+			}
+		}
+	}
+}
+
+template<colour TURN>
+void MoveGenDefault::_find_deep_capture(MoveList& moves, Move& move, int8_t row, int8_t column, bool(&captured)[8][8]) const
+{
+	static constexpr int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
+	for (size_t dir = 0; dir < 4; ++dir)
+	{
+		const int r1 = row + d_row[dir], c1 = column + d_column[dir], r2 = r1 + d_row[dir], c2 = c1 + d_column[dir];
+		if (r2 < 0 || c2 < 0 || r2 > 7 || c2 > 7 || board[r2][c2].get_type() != PT_EMPTY
+			|| board[r1][c1].get_colour() != opposite(TURN) || captured[r1][c1])
+			continue;
+		move.add_step(Position(r2, c2)); // Correct capture-move
+		move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
+		const int old = moves.size();
+		captured[r1][c1] = true; // For preventing 'recapturing' piece at (r1; c1) in moves produced by recursive call to this function(next 4 lines)
+		if (TURN == WHITE ? (r2 == 7) : (r2 == 0)) // We can become queen at this move
+		{
+			_find_deep_capture_queen<TURN>(moves, move, r2, c2, captured);
+			if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
+			{
+				move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN));
+				moves.emplace(move);
+			}
+		}
+		else
+		{
+			_find_deep_capture<TURN>(moves, move, r2, c2, captured);
+			if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
+			{
+				move.set_become(Piece(TURN == WHITE ? WHITE_SIMPLE : BLACK_SIMPLE));
+				moves.emplace(move);
+			}
+		}
+		captured[r1][c1] = false; // For correct work on next cycles we should clear changes to 'captured' and 'move' variables
+		move.pop_step();
+		move.pop_capture();
+	}
+}
+
+template<colour TURN>
+void MoveGenDefault::_find_deep_capture_queen(MoveList& moves, Move& move, int8_t row, int8_t column, bool(&captured)[8][8]) const
+{
+	for (size_t dir = 0; dir < 4; ++dir)
+	{
+		const int length = DIAGONAL_RAYS.length[row][column][dir];
+		const int8_t* const ray_row = DIAGONAL_RAYS.row[row][column][dir];
+		const int8_t* const ray_column = DIAGONAL_RAYS.column[row][column][dir];
+		// Skip empty squares up to the first piece. It can be captured only if it is opponent's, isn't captured yet
+		// and isn't the last square of the ray (there should be a square behind it)
+		int k = 0;
+		while (k < length && board[ray_row[k]][ray_column[k]].get_colour() < WHITE)
+			++k;
+		if (k + 1 >= length || board[ray_row[k]][ray_column[k]].get_colour() != opposite(TURN)
+			|| captured[ray_row[k]][ray_column[k]])
+			continue;
+		const int r1 = ray_row[k], c1 = ray_column[k];
+		// Landing squares are empty ones behind the captured piece
+		int landing_end = k + 1;
+		while (landing_end < length && board[ray_row[landing_end]][ray_column[landing_end]].get_type() == PT_EMPTY)
+			++landing_end;
+		captured[r1][c1] = true;
+		const int old = moves.size();
+		for (int l = k + 1; l < landing_end; ++l)
+		{
+			move.add_step(Position(ray_row[l], ray_column[l]));
+			move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
+			_find_deep_capture_queen<TURN>(moves, move, ray_row[l], ray_column[l], captured);
+			move.pop_step();
+			move.pop_capture();
+		}
+		if (old == moves.size()) // If in recursive calls we haven't found any move, then any move is a final capture in this direction and is one of possible captures
+			for (int l = k + 1; l < landing_end; ++l)
+			{
+				move.add_step(Position(ray_row[l], ray_column[l]));
+				move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
+				move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN));
+				moves.emplace(move);
+				move.pop_step();
+				move.pop_capture();
+			}
+		captured[r1][c1] = false;
+	}
+}
+
+template<colour TURN>
+bool MoveGenDefault::_has_capture(void) const
+{
+	static constexpr int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
+	// Simple pieces capture in all directions
+	for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
+	{
+		const auto& pos = board.piece_list[turn_simple(TURN)][i];
+		for (size_t dir = 0; dir < 4; ++dir)
+		{
+			const int r2 = pos.row + 2 * d_row[dir], c2 = pos.column + 2 * d_column[dir];
+			if (r2 >= 0 && c2 >= 0 && r2 <= 7 && c2 <= 7 && board[r2][c2].get_type() == PT_EMPTY
+				&& board[pos.row + d_row[dir]][pos.column + d_column[dir]].get_colour() == opposite(TURN))
+				return true;
+		}
+	}
+	// Queens capture the first opponent's piece on a diagonal if the square behind it is empty
+	for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
+	{
+		const auto& pos = board.piece_list[turn_queen(TURN)][i];
+		for (size_t dir = 0; dir < 4; ++dir)
+		{
+			const int length = DIAGONAL_RAYS.length[pos.row][pos.column][dir];
+			const int8_t* const ray_row = DIAGONAL_RAYS.row[pos.row][pos.column][dir];
+			const int8_t* const ray_column = DIAGONAL_RAYS.column[pos.row][pos.column][dir];
+			int k = 0;
+			while (k < length && board[ray_row[k]][ray_column[k]].get_colour() < WHITE)
+				++k;
+			if (k + 1 < length && board[ray_row[k]][ray_column[k]].get_colour() == opposite(TURN)
+				&& board[ray_row[k + 1]][ray_column[k + 1]].get_type() == PT_EMPTY)
+				return true;
+		}
+	}
+	return false;
+}
+
+template<colour TURN, move_type MT>
+void MoveGenEnglish::_get_all_moves(MoveList& moves) const
+{
+	bool capture[8][8] = {}; // Local, so that move generation is safe for concurrent boards
+	// Search for capture-moves first
+	if (MT != NON_CAPTURE)
+	{
+		for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
+		{
+			const auto& pos = board.piece_list[turn_simple(TURN)][i];
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			_find_deep_capture<TURN>(moves, move, pos.row, pos.column);
+		}
+		for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
+		{
+			const auto& pos = board.piece_list[turn_queen(TURN)][i];
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			tmp_assign<Piece> move_begin(const_cast<Piece&>
+				(board[pos.row][pos.column]), Piece(PT_EMPTY)); // Because this position is empty when we move from it
+			_find_deep_capture_queen<TURN>(moves, move, pos.row, pos.column, capture);
+		}
+	}
+	// Capture-move is mandatory, so we need to check non-capture moves only when we don't have any capture-moves
+	if (MT == CAPTURE || !moves.empty())
+		return;
+	for (int i = 0; i < board.piece_count[turn_simple(TURN)]; ++i)
+	{
+		const auto& pos = board.piece_list[turn_simple(TURN)][i];
+		if (pos.column < 7 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column + 1].get_type() == PT_EMPTY)
+		{
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			if (TURN == WHITE)
+			{
+				move.add_step(Position(pos.row + 1, pos.column + 1));
+				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
+			}
+			else
+			{
+				move.add_step(Position(pos.row - 1, pos.column + 1));
+				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
+			}
+			moves.emplace(std::move(move));
+		}
+		if (pos.column > 0 && board[TURN == WHITE ? pos.row + 1 : pos.row - 1][pos.column - 1].get_type() == PT_EMPTY)
+		{
+			Move move(pos);
+			move.set_original(board[pos.row][pos.column]);
+			if (TURN == WHITE)
+			{
+				move.add_step(Position(pos.row + 1, pos.column - 1));
+				move.set_become(pos.row == 6 ? Piece(WHITE_QUEEN) : Piece(WHITE_SIMPLE));
+			}
+			else
+			{
+				move.add_step(Position(pos.row - 1, pos.column - 1));
+				move.set_become(pos.row == 1 ? Piece(BLACK_QUEEN) : Piece(BLACK_SIMPLE));
+			}
+			moves.emplace(std::move(move));
+		}
+	}
+	for (int i = 0; i < board.piece_count[turn_queen(TURN)]; ++i)
+	{
+		const auto& pos = board.piece_list[turn_queen(TURN)][i];
+		constexpr int dx[4] = { 1, 1, -1, -1 }, dy[4] = { 1, -1, 1, -1 };
+		for (size_t dir = 0; dir < 4; ++dir)
+		{
+			const int r = pos.row + dy[dir], c = pos.column + dx[dir]; // In english ckeckers queen moves only 1 square in each direction
+			if (r < 8 && c < 8 && r >= 0 && c >= 0 && board[r][c].get_type() == PT_EMPTY)
+			{
+				Move move(pos);
+				move.add_step(Position(r, c));
+				move.set_original(board[pos.row][pos.column]);
+				move.set_become(TURN == WHITE ? Piece(WHITE_QUEEN) : Piece(BLACK_QUEEN));
+				moves.emplace(std::move(move));
+			}
+		}
+	}
+}
+
+template<colour TURN>
+void MoveGenEnglish::_find_deep_capture(MoveList& moves, Move& move, int8_t row, int8_t column) const
+{
+	static constexpr int d_row = (TURN == WHITE ? 1 : -1), d_column[2] = { 1, -1 };
+	const int r1 = row + d_row, r2 = r1 + d_row;
+	if (r2 < 0 || r2 > 7)
+		return;
+	for (size_t dir = 0; dir < 2; ++dir)
+	{
+		const int c1 = column + d_column[dir], c2 = c1 + d_column[dir];
+		if (c2 < 0 || c2 > 7 || board[r2][c2].get_type() != PT_EMPTY
+			|| board[r1][c1].get_colour() != opposite(TURN))
+			continue;
+		move.add_step(Position(r2, c2)); // Correct capture-move
+		move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
+		const size_t old = moves.size();
+		if (TURN == WHITE ? (r2 == 7) : (r2 == 0)) // We can become queen at this move
+		{
+			move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN)); // In english checkers move is stopped when piece becomes queen
+			moves.emplace(move);
+		}
+		else
+		{
+			_find_deep_capture<TURN>(moves, move, r2, c2);
+			if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
+			{
+				move.set_become(Piece(TURN == WHITE ? WHITE_SIMPLE : BLACK_SIMPLE));
+				moves.emplace(move);
+			}
+		}
+		move.pop_step();
+		move.pop_capture();
+	}
+}
+
+template<colour TURN>
+void MoveGenEnglish::_find_deep_capture_queen(MoveList& moves, Move& move, int8_t row, int8_t column, bool(&captured)[8][8]) const
+{
+	static constexpr int d_row[4] = { 1, 1, -1, -1 }, d_column[4] = { 1, -1, 1, -1 };
+	for (size_t dir = 0; dir < 4; ++dir)
+	{
+		// In english checkers we can jump only over adjacent pieces
+		const int r1 = row + d_row[dir], c1 = column + d_column[dir], r2 = r1 + d_row[dir], c2 = c1 + d_column[dir];
+		if (r2 < 0 || c2 < 0 || r2 > 7 || c2 > 7 || board[r2][c2].get_type() != PT_EMPTY
+			|| board[r1][c1].get_colour() != opposite(TURN) || captured[r1][c1])
+			continue;
+		move.add_step(Position(r2, c2)); // Correct capture-move
+		move.add_capture(std::make_pair(Position(r1, c1), board[r1][c1]));
+		const size_t old = moves.size();
+		captured[r1][c1] = true; // For preventing 'recapturing' piece at (r1; c1) in moves produced by recursive call to this function(next 4 lines)
+		_find_deep_capture_queen<TURN>(moves, move, r2, c2, captured);
+		if (old == moves.size()) // If in recursive call we haven't found any move, then 'move' is a final capture and is one of possible captures
+		{
+			move.set_become(Piece(TURN == WHITE ? WHITE_QUEEN : BLACK_QUEEN));
+			moves.emplace(move);
+		}
+		captured[r1][c1] = false; // For correct work on next cycles we should clear changes to 'captured' and 'move' variables
+		move.pop_step();
+		move.pop_capture();
+	}
+}
+
+template<colour TURN>
+bool MoveGenEnglish::_has_capture(void) const
+{
+	static constexpr int d_row[4] = { TURN == WHITE ? 1 : -1, TURN == WHITE ? 1 : -1,
+		TURN == WHITE ? -1 : 1, TURN == WHITE ? -1 : 1 }, d_column[4] = { 1, -1, 1, -1 };
+	// Simple pieces capture only forward (the first two directions), queens capture adjacent pieces in all directions
+	for (int pt = turn_simple(TURN), dir_count = 2; dir_count <= 4; pt = turn_queen(TURN), dir_count += 2)
+		for (int i = 0; i < board.piece_count[pt]; ++i)
+		{
+			const auto& pos = board.piece_list[pt][i];
+			for (int dir = 0; dir < dir_count; ++dir)
+			{
+				const int r2 = pos.row + 2 * d_row[dir], c2 = pos.column + 2 * d_column[dir];
+				if (r2 >= 0 && c2 >= 0 && r2 <= 7 && c2 <= 7 && board[r2][c2].get_type() == PT_EMPTY
+					&& board[pos.row + d_row[dir]][pos.column + d_column[dir]].get_colour() == opposite(TURN))
+					return true;
+			}
+		}
+	return false;
+}
+
+// Explicit template instantiations
+template bool	MoveGen::_has_non_capture<WHITE>(void) const;
+template bool	MoveGen::_has_non_capture<BLACK>(void) const;
+template void	MoveGenDefault::_find_deep_capture<WHITE>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+template void	MoveGenDefault::_find_deep_capture<BLACK>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+template void	MoveGenDefault::_find_deep_capture_queen<WHITE>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+template void	MoveGenDefault::_find_deep_capture_queen<BLACK>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+template void	MoveGenDefault::_get_all_moves<WHITE, ALL>(MoveList&) const;
+template void	MoveGenDefault::_get_all_moves<WHITE, CAPTURE>(MoveList&) const;
+template void	MoveGenDefault::_get_all_moves<WHITE, NON_CAPTURE>(MoveList&) const;
+template void	MoveGenDefault::_get_all_moves<BLACK, ALL>(MoveList&) const;
+template void	MoveGenDefault::_get_all_moves<BLACK, CAPTURE>(MoveList&) const;
+template void	MoveGenDefault::_get_all_moves<BLACK, NON_CAPTURE>(MoveList&) const;
+template bool	MoveGenDefault::_has_capture<WHITE>(void) const;
+template bool	MoveGenDefault::_has_capture<BLACK>(void) const;
+template void	MoveGenEnglish::_find_deep_capture<WHITE>(MoveList&, Move&, int8_t, int8_t) const;
+template void	MoveGenEnglish::_find_deep_capture<BLACK>(MoveList&, Move&, int8_t, int8_t) const;
+template void	MoveGenEnglish::_find_deep_capture_queen<WHITE>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+template void	MoveGenEnglish::_find_deep_capture_queen<BLACK>(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+template void	MoveGenEnglish::_get_all_moves<WHITE, ALL>(MoveList&) const;
+template void	MoveGenEnglish::_get_all_moves<WHITE, CAPTURE>(MoveList&) const;
+template void	MoveGenEnglish::_get_all_moves<WHITE, NON_CAPTURE>(MoveList&) const;
+template void	MoveGenEnglish::_get_all_moves<BLACK, ALL>(MoveList&) const;
+template void	MoveGenEnglish::_get_all_moves<BLACK, CAPTURE>(MoveList&) const;
+template void	MoveGenEnglish::_get_all_moves<BLACK, NON_CAPTURE>(MoveList&) const;
+template bool	MoveGenEnglish::_has_capture<WHITE>(void) const;
+template bool	MoveGenEnglish::_has_capture<BLACK>(void) const;
\ No newline at end of file
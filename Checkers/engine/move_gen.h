@@ -1,193 +1,256 @@
-/*
-========================================================================
-Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
-
-This file is part of Checkers source code
-
-Checkers is free software : you can redistribute it and / or modify
-it under the terms of the GNU General Public License as published by
-the Free Software Foundation, either version 3 of the License, or
-(at your option) any later version.
-
-Checkers is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
-GNU General Public License for more details.
-
-You should have received a copy of the GNU General Public License
-along with Checkers.If not, see <http://www.gnu.org/licenses/>
-========================================================================
-*/
-
-// move_gen.h, version 1.7
-
-#pragma once
-#ifndef _MOVEGEN_H
-#define _MOVEGEN_H
-#include "move.h"
-
-constexpr int MAX_MOVES_COUNT = 100;
-enum move_type : int8_t { ALL, CAPTURE, NON_CAPTURE };
-
-struct MLNode
-{
-	Move move;
-	float score;
-};
-
-inline bool operator>(const MLNode& ml1, const MLNode& ml2)
-{
-	return ml1.score > ml2.score;
-}
-
-typedef SVector<MLNode, MAX_MOVES_COUNT> MoveList;
-
-class MoveGen
-{
-public:
-	MoveGen(const Board& b)
-		: board(b)
-	{}
-	template<colour, move_type = ALL>
-	inline void get_all_moves(MoveList&) const; // Outputs to given vector all possible moves
-protected:
-	virtual void get_all_moves_WHITE_ALL(MoveList&) const = 0;
-	virtual void get_all_moves_WHITE_CAPTURE(MoveList&) const = 0;
-	virtual void get_all_moves_WHITE_NON_CAPTURE(MoveList&) const = 0;
-	virtual void get_all_moves_BLACK_ALL(MoveList&) const = 0;
-	virtual void get_all_moves_BLACK_CAPTURE(MoveList&) const = 0;
-	virtual void get_all_moves_BLACK_NON_CAPTURE(MoveList&) const = 0;
-	const Board& board;
-};
-
-class MoveGenDefault
-	: public MoveGen
-{
-public:
-	MoveGenDefault(const Board& b)
-		: MoveGen(b)
-	{}
-protected:
-	virtual inline void get_all_moves_WHITE_ALL(MoveList&) const override;
-	virtual inline void get_all_moves_WHITE_CAPTURE(MoveList&) const override;
-	virtual inline void get_all_moves_WHITE_NON_CAPTURE(MoveList&) const override;
-	virtual inline void get_all_moves_BLACK_ALL(MoveList&) const override;
-	virtual inline void get_all_moves_BLACK_CAPTURE(MoveList&) const override;
-	virtual inline void get_all_moves_BLACK_NON_CAPTURE(MoveList&) const override;
-	// Helper function for finding all capture-moves that can be done by a piece with given coordinates
-	template<colour>
-	void _find_deep_capture(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-	// Same but for queen pieces
-	template<colour>
-	void _find_deep_capture_queen(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-	// Main generating function
-	template<colour, move_type>
-	void _get_all_moves(MoveList&) const;
-};
-
-class MoveGenEnglish
-	: public MoveGen
-{
-public:
-	MoveGenEnglish(const Board& b)
-		: MoveGen(b)
-	{}
-protected:
-	virtual inline void get_all_moves_WHITE_ALL(MoveList&) const override;
-	virtual inline void get_all_moves_WHITE_CAPTURE(MoveList&) const override;
-	virtual inline void get_all_moves_WHITE_NON_CAPTURE(MoveList&) const override;
-	virtual inline void get_all_moves_BLACK_ALL(MoveList&) const override;
-	virtual inline void get_all_moves_BLACK_CAPTURE(MoveList&) const override;
-	virtual inline void get_all_moves_BLACK_NON_CAPTURE(MoveList&) const override;
-	// Helper function for finding all capture-moves that can be done by a piece with given coordinates
-	template<colour>
-	void _find_deep_capture(MoveList&, Move&, int8_t, int8_t) const;
-	// Same but for queen pieces
-	template<colour>
-	void _find_deep_capture_queen(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
-	// Main generating function
-	template<colour, move_type>
-	void _get_all_moves(MoveList&) const;
-};
-
-template<colour TURN, move_type MT>
-inline void MoveGen::get_all_moves(MoveList& vec) const
-{
-	static_assert(TURN == WHITE || TURN == BLACK, "TURN must be either WHITE or BLACK");
-	if (TURN == WHITE)
-		if (MT == ALL)
-			get_all_moves_WHITE_ALL(vec);
-		else if (MT == CAPTURE)
-			get_all_moves_WHITE_CAPTURE(vec);
-		else
-			get_all_moves_WHITE_NON_CAPTURE(vec);
-	else
-		if (MT == ALL)
-			get_all_moves_BLACK_ALL(vec);
-		else if (MT == CAPTURE)
-			get_all_moves_BLACK_CAPTURE(vec);
-		else
-			get_all_moves_BLACK_NON_CAPTURE(vec);
-}
-
-inline void MoveGenDefault::get_all_moves_WHITE_ALL(MoveList& vec) const
-{
-	_get_all_moves<WHITE, ALL>(vec);
-}
-
-inline void MoveGenDefault::get_all_moves_WHITE_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<WHITE, CAPTURE>(vec);
-}
-
-inline void MoveGenDefault::get_all_moves_WHITE_NON_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<WHITE, NON_CAPTURE>(vec);
-}
-
-inline void MoveGenDefault::get_all_moves_BLACK_ALL(MoveList& vec) const
-{
-	_get_all_moves<BLACK, ALL>(vec);
-}
-
-inline void MoveGenDefault::get_all_moves_BLACK_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<BLACK, CAPTURE>(vec);
-}
-
-inline void MoveGenDefault::get_all_moves_BLACK_NON_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<BLACK, NON_CAPTURE>(vec);
-}
-
-inline void MoveGenEnglish::get_all_moves_WHITE_ALL(MoveList& vec) const
-{
-	_get_all_moves<WHITE, ALL>(vec);
-}
-
-inline void MoveGenEnglish::get_all_moves_WHITE_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<WHITE, CAPTURE>(vec);
-}
-
-inline void MoveGenEnglish::get_all_moves_WHITE_NON_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<WHITE, NON_CAPTURE>(vec);
-}
-
-inline void MoveGenEnglish::get_all_moves_BLACK_ALL(MoveList& vec) const
-{
-	_get_all_moves<BLACK, ALL>(vec);
-}
-
-inline void MoveGenEnglish::get_all_moves_BLACK_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<BLACK, CAPTURE>(vec);
-}
-
-inline void MoveGenEnglish::get_all_moves_BLACK_NON_CAPTURE(MoveList& vec) const
-{
-	_get_all_moves<BLACK, NON_CAPTURE>(vec);
-}
-
+/*
+========================================================================
+Copyright (c) 2016-2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// move_gen.h, version 1.8
+
+#pragma once
+#ifndef _MOVEGEN_H
+#define _MOVEGEN_H
+#include "move.h"
+
+class Board;
+
+constexpr int MAX_MOVES_COUNT = 100;
+enum move_type : int8_t { ALL, CAPTURE, NON_CAPTURE };
+
+struct MLNode
+{
+	Move move;
+	float score;
+};
+
+inline bool operator>(const MLNode& ml1, const MLNode& ml2)
+{
+	return ml1.score > ml2.score;
+}
+
+typedef SVector<MLNode, MAX_MOVES_COUNT> MoveList;
+
+// Removes capture-moves which lead to the same position as an earlier move of the list, i.e. have the same origin,
+// destination, resulting piece and set of captured pieces but another path (e.g. flying king's ring captures).
+// Search examines such moves once then. Remaining moves keep their order, so the first path is the representative.
+// Generators keep all paths, since they are distinct moves for notation and move input
+void remove_equivalent_captures(MoveList&) noexcept;
+
+class MoveGen
+{
+public:
+	MoveGen(const Board& b)
+		: board(b)
+	{}
+	template<colour, move_type = ALL>
+	inline void get_all_moves(MoveList&) const; // Outputs to given vector all possible moves
+	// Predicates which answer by looking at neighbourhood of pieces, without generating move paths
+	template<colour>
+	inline bool has_capture(void) const; // Returns whether any capture-move exists
+	template<colour>
+	inline bool has_any_move(void) const; // Returns whether any move exists
+protected:
+	virtual void get_all_moves_WHITE_ALL(MoveList&) const = 0;
+	virtual void get_all_moves_WHITE_CAPTURE(MoveList&) const = 0;
+	virtual void get_all_moves_WHITE_NON_CAPTURE(MoveList&) const = 0;
+	virtual void get_all_moves_BLACK_ALL(MoveList&) const = 0;
+	virtual void get_all_moves_BLACK_CAPTURE(MoveList&) const = 0;
+	virtual void get_all_moves_BLACK_NON_CAPTURE(MoveList&) const = 0;
+	virtual bool has_capture_WHITE(void) const = 0;
+	virtual bool has_capture_BLACK(void) const = 0;
+	// Returns whether any non-capture move exists. The check is the same for all rules, since a king
+	// which can move at all can move to an adjacent square
+	template<colour>
+	bool _has_non_capture(void) const;
+	const Board& board;
+};
+
+class MoveGenDefault
+	: public MoveGen
+{
+public:
+	MoveGenDefault(const Board& b)
+		: MoveGen(b)
+	{}
+protected:
+	virtual inline void get_all_moves_WHITE_ALL(MoveList&) const override;
+	virtual inline void get_all_moves_WHITE_CAPTURE(MoveList&) const override;
+	virtual inline void get_all_moves_WHITE_NON_CAPTURE(MoveList&) const override;
+	virtual inline void get_all_moves_BLACK_ALL(MoveList&) const override;
+	virtual inline void get_all_moves_BLACK_CAPTURE(MoveList&) const override;
+	virtual inline void get_all_moves_BLACK_NON_CAPTURE(MoveList&) const override;
+	virtual inline bool has_capture_WHITE(void) const override;
+	virtual inline bool has_capture_BLACK(void) const override;
+	// Helper function for finding all capture-moves that can be done by a piece with given coordinates
+	template<colour>
+	void _find_deep_capture(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+	// Same but for queen pieces
+	template<colour>
+	void _find_deep_capture_queen(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+	// Main generating function
+	template<colour, move_type>
+	void _get_all_moves(MoveList&) const;
+	// Main capture-move existence check
+	template<colour>
+	bool _has_capture(void) const;
+};
+
+class MoveGenEnglish
+	: public MoveGen
+{
+public:
+	MoveGenEnglish(const Board& b)
+		: MoveGen(b)
+	{}
+protected:
+	virtual inline void get_all_moves_WHITE_ALL(MoveList&) const override;
+	virtual inline void get_all_moves_WHITE_CAPTURE(MoveList&) const override;
+	virtual inline void get_all_moves_WHITE_NON_CAPTURE(MoveList&) const override;
+	virtual inline void get_all_moves_BLACK_ALL(MoveList&) const override;
+	virtual inline void get_all_moves_BLACK_CAPTURE(MoveList&) const override;
+	virtual inline void get_all_moves_BLACK_NON_CAPTURE(MoveList&) const override;
+	virtual inline bool has_capture_WHITE(void) const override;
+	virtual inline bool has_capture_BLACK(void) const override;
+	// Helper function for finding all capture-moves that can be done by a piece with given coordinates
+	template<colour>
+	void _find_deep_capture(MoveList&, Move&, int8_t, int8_t) const;
+	// Same but for queen pieces
+	template<colour>
+	void _find_deep_capture_queen(MoveList&, Move&, int8_t, int8_t, bool(&)[8][8]) const;
+	// Main generating function
+	template<colour, move_type>
+	void _get_all_moves(MoveList&) const;
+	// Main capture-move existence check
+	template<colour>
+	bool _has_capture(void) const;
+};
+
+template<colour TURN, move_type MT>
+inline void MoveGen::get_all_moves(MoveList& vec) const
+{
+	static_assert(TURN == WHITE || TURN == BLACK, "TURN must be either WHITE or BLACK");
+	if (TURN == WHITE)
+		if (MT == ALL)
+			get_all_moves_WHITE_ALL(vec);
+		else if (MT == CAPTURE)
+			get_all_moves_WHITE_CAPTURE(vec);
+		else
+			get_all_moves_WHITE_NON_CAPTURE(vec);
+	else
+		if (MT == ALL)
+			get_all_moves_BLACK_ALL(vec);
+		else if (MT == CAPTURE)
+			get_all_moves_BLACK_CAPTURE(vec);
+		else
+			get_all_moves_BLACK_NON_CAPTURE(vec);
+}
+
+template<colour TURN>
+inline bool MoveGen::has_capture(void) const
+{
+	static_assert(TURN == WHITE || TURN == BLACK, "TURN must be either WHITE or BLACK");
+	return TURN == WHITE ? has_capture_WHITE() : has_capture_BLACK();
+}
+
+template<colour TURN>
+inline bool MoveGen::has_any_move(void) const
+{
+	// Non-capture check is cheaper and it is enough in most positions
+	return _has_non_capture<TURN>() || has_capture<TURN>();
+}
+
+inline void MoveGenDefault::get_all_moves_WHITE_ALL(MoveList& vec) const
+{
+	_get_all_moves<WHITE, ALL>(vec);
+}
+
+inline void MoveGenDefault::get_all_moves_WHITE_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<WHITE, CAPTURE>(vec);
+}
+
+inline void MoveGenDefault::get_all_moves_WHITE_NON_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<WHITE, NON_CAPTURE>(vec);
+}
+
+inline void MoveGenDefault::get_all_moves_BLACK_ALL(MoveList& vec) const
+{
+	_get_all_moves<BLACK, ALL>(vec);
+}
+
+inline void MoveGenDefault::get_all_moves_BLACK_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<BLACK, CAPTURE>(vec);
+}
+
+inline void MoveGenDefault::get_all_moves_BLACK_NON_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<BLACK, NON_CAPTURE>(vec);
+}
+
+inline bool MoveGenDefault::has_capture_WHITE(void) const
+{
+	return _has_capture<WHITE>();
+}
+
+inline bool MoveGenDefault::has_capture_BLACK(void) const
+{
+	return _has_capture<BLACK>();
+}
+
+inline void MoveGenEnglish::get_all_moves_WHITE_ALL(MoveList& vec) const
+{
+	_get_all_moves<WHITE, ALL>(vec);
+}
+
+inline void MoveGenEnglish::get_all_moves_WHITE_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<WHITE, CAPTURE>(vec);
+}
+
+inline void MoveGenEnglish::get_all_moves_WHITE_NON_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<WHITE, NON_CAPTURE>(vec);
+}
+
+inline void MoveGenEnglish::get_all_moves_BLACK_ALL(MoveList& vec) const
+{
+	_get_all_moves<BLACK, ALL>(vec);
+}
+
+inline void MoveGenEnglish::get_all_moves_BLACK_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<BLACK, CAPTURE>(vec);
+}
+
+inline void MoveGenEnglish::get_all_moves_BLACK_NON_CAPTURE(MoveList& vec) const
+{
+	_get_all_moves<BLACK, NON_CAPTURE>(vec);
+}
+
+inline bool MoveGenEnglish::has_capture_WHITE(void) const
+{
+	return _has_capture<WHITE>();
+}
+
+inline bool MoveGenEnglish::has_capture_BLACK(void) const
+{
+	return _has_capture<BLACK>();
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// nnue.cpp, version 1.8
+
+#include "nnue.h"
+#include "misc.h"
+#include <fstream>
+#include <cstring>
+
+namespace
+{
+	constexpr char NNUE_MAGIC[8] = { 'C', 'H', 'K', 'R', 'S', 'N', 'N', '1' };
+}
+
+NNUE::NNUE(void) noexcept
+	: weights(), rules(RULES_DEFAULT), misere(false), loaded(false)
+{}
+
+NNUE::~NNUE(void) noexcept = default;
+
+void NNUE::set_weights(const NNUEWeights& w, game_rules rule, bool mis) noexcept
+{
+	weights = w;
+	rules = rule;
+	misere = mis;
+	loaded = true;
+}
+
+void NNUE::load(const std::string& file_name)
+{
+	std::ifstream in(file_name, std::ios::binary);
+	if (!in)
+		throw(checkers_error("Unable to open network file " + file_name));
+	load(in);
+}
+
+void NNUE::load(std::istream& istr)
+{
+	char magic[sizeof(NNUE_MAGIC)];
+	int8_t rule, mis;
+	loaded = false;
+	if (!istr.read(magic, sizeof(magic)) || std::memcmp(magic, NNUE_MAGIC, sizeof(magic)) != 0)
+		throw(checkers_error("Network has wrong format"));
+	istr.read(reinterpret_cast<char*>(&rule), sizeof(rule));
+	istr.read(reinterpret_cast<char*>(&mis), sizeof(mis));
+	if (!istr || (rule != RULES_DEFAULT && rule != RULES_ENGLISH))
+		throw(checkers_error("Network header is corrupted"));
+	if (!istr.read(reinterpret_cast<char*>(&weights), sizeof(weights)))
+		throw(checkers_error("Network weights are corrupted"));
+	rules = static_cast<game_rules>(rule);
+	misere = (mis != 0);
+	loaded = true;
+}
+
+void NNUE::save(const std::string& file_name) const
+{
+	std::ofstream out(file_name, std::ios::binary);
+	if (!out)
+		throw(checkers_error("Unable to create network file " + file_name));
+	save(out);
+}
+
+void NNUE::save(std::ostream& ostr) const
+{
+	const int8_t rule = rules, mis = misere;
+	ostr.write(NNUE_MAGIC, sizeof(NNUE_MAGIC));
+	ostr.write(reinterpret_cast<const char*>(&rule), sizeof(rule));
+	ostr.write(reinterpret_cast<const char*>(&mis), sizeof(mis));
+	ostr.write(reinterpret_cast<const char*>(&weights), sizeof(weights));
+}
+
+void NNUE::refresh(NNUEAccumulator& acc, const Board& board) const noexcept
+{
+	std::memcpy(acc.values[0], weights.feature_bias, sizeof(weights.feature_bias));
+	std::memcpy(acc.values[1], weights.feature_bias, sizeof(weights.feature_bias));
+	for (int row = 0; row < 8; ++row)
+		for (int col = row & 1; col < 8; col += 2)
+			if (board.get_cell(row, col).get_type() != PT_EMPTY)
+				add_piece(acc, board.get_cell(row, col).get_type(), Position(row, col));
+}
+
+int16_t NNUE::evaluate(const NNUEAccumulator& acc, colour turn) const noexcept
+{
+	// Clipped accumulators of side to move and the opponent
+	uint8_t input[2 * NNUE_HIDDEN];
+	const int16_t* perspective[2] = { acc.values[turn - WHITE], acc.values[opposite(turn) - WHITE] };
+#if defined NNUE_USE_AVX2
+	const __m256i act_max = _mm256_set1_epi16(NNUE_ACTIVATION_MAX);
+	for (int p = 0; p < 2; ++p)
+		for (int i = 0; i < NNUE_HIDDEN; i += 32)
+		{
+			const __m256i lo = _mm256_min_epi16(act_max,
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(perspective[p] + i)));
+			const __m256i hi = _mm256_min_epi16(act_max,
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(perspective[p] + i + 16)));
+			// Packing saturates negative values to 0, but interleaves 128-bit lanes, so they are permuted back
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(input + p * NNUE_HIDDEN + i),
+				_mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8));
+		}
+#elif defined NNUE_USE_SSE2
+	const __m128i act_max = _mm_set1_epi16(NNUE_ACTIVATION_MAX);
+	for (int p = 0; p < 2; ++p)
+		for (int i = 0; i < NNUE_HIDDEN; i += 16)
+		{
+			const __m128i lo = _mm_min_epi16(act_max,
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(perspective[p] + i)));
+			const __m128i hi = _mm_min_epi16(act_max,
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(perspective[p] + i + 8)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(input + p * NNUE_HIDDEN + i), _mm_packus_epi16(lo, hi));
+		}
+#else
+	for (int p = 0; p < 2; ++p)
+		for (int i = 0; i < NNUE_HIDDEN; ++i)
+			input[p * NNUE_HIDDEN + i] = uint8_t(std::min<int>(std::max<int>(perspective[p][i], 0), NNUE_ACTIVATION_MAX));
+#endif
+	// Second layer
+	int32_t out = weights.output_bias;
+	for (int j = 0; j < NNUE_L2; ++j)
+	{
+		const int8_t* row = weights.l2_weights[j];
+		int32_t sum = weights.l2_bias[j];
+#if defined NNUE_USE_AVX2
+		// Products of unsigned inputs and signed weights are summed in pairs (without overflow, because inputs
+		// are at most 127), then widened to 32 bits
+		const __m256i ones = _mm256_set1_epi16(1);
+		__m256i vsum = _mm256_setzero_si256();
+		for (int i = 0; i < 2 * NNUE_HIDDEN; i += 32)
+			vsum = _mm256_add_epi32(vsum, _mm256_madd_epi16(_mm256_maddubs_epi16(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i))), ones));
+		__m128i hsum = _mm_add_epi32(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1));
+		hsum = _mm_add_epi32(hsum, _mm_shuffle_epi32(hsum, 0x4E));
+		hsum = _mm_add_epi32(hsum, _mm_shuffle_epi32(hsum, 0xB1));
+		sum += _mm_cvtsi128_si32(hsum);
+#elif defined NNUE_USE_SSE2
+		// Inputs are zero-extended and weights are sign-extended to 16 bits
+		const __m128i zero = _mm_setzero_si128();
+		__m128i vsum = _mm_setzero_si128();
+		for (int i = 0; i < 2 * NNUE_HIDDEN; i += 16)
+		{
+			const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+			const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+			vsum = _mm_add_epi32(vsum, _mm_madd_epi16(_mm_unpacklo_epi8(in, zero),
+				_mm_srai_epi16(_mm_unpacklo_epi8(w, w), 8)));
+			vsum = _mm_add_epi32(vsum, _mm_madd_epi16(_mm_unpackhi_epi8(in, zero),
+				_mm_srai_epi16(_mm_unpackhi_epi8(w, w), 8)));
+		}
+		vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0x4E));
+		vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0xB1));
+		sum += _mm_cvtsi128_si32(vsum);
+#else
+		for (int i = 0; i < 2 * NNUE_HIDDEN; ++i)
+			sum += input[i] * row[i];
+#endif
+		// Output layer is small, so it is accumulated right away
+		out += weights.output_weights[j] * std::min(std::max(sum >> NNUE_L2_SHIFT, 0), NNUE_ACTIVATION_MAX);
+	}
+	return int16_t(std::min(std::max(out / NNUE_OUTPUT_DIVISOR, -NNUE_MAX_SCORE), NNUE_MAX_SCORE));
+}
\ No newline at end of file
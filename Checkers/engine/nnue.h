@@ -0,0 +1,179 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// nnue.h, version 1.8
+
+#pragma once
+#ifndef _NNUE_H
+#define _NNUE_H
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include "board.h"
+
+#if defined __AVX2__
+#define NNUE_USE_AVX2
+#include <immintrin.h>
+#elif defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define NNUE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// Sizes of the network layers
+constexpr int NNUE_FEATURES = 128; // Piece kind (own/opponent's simple/queen) x 32 playable squares
+constexpr int NNUE_HIDDEN = 128; // Size of the accumulator of each perspective
+constexpr int NNUE_L2 = 32; // Size of the second hidden layer
+constexpr int NNUE_ACTIVATION_MAX = 127; // Clipped ReLU upper bound (represents 1.0)
+constexpr int NNUE_L2_SHIFT = 6; // Scale of second layer weights is 1 << NNUE_L2_SHIFT
+constexpr int NNUE_OUTPUT_DIVISOR = 16; // Divisor of output layer sum which gives score
+constexpr int NNUE_MAX_SCORE = 3000; // Bound of score absolute value (keeps it away from special scores)
+
+// Quantized network parameters. Evaluation (for side to move) is
+// 1) accumulator of each perspective: feature_bias + sum of feature_weights of its active features
+// 2) input: clamp(accumulator, 0, 127) of side to move followed by the opponent's
+// 3) hidden: clamp((l2_bias + l2_weights * input) >> NNUE_L2_SHIFT, 0, 127)
+// 4) score: (output_bias + output_weights * hidden) / NNUE_OUTPUT_DIVISOR, clamped to NNUE_MAX_SCORE
+struct NNUEWeights
+{
+	int16_t feature_weights[NNUE_FEATURES][NNUE_HIDDEN];
+	int16_t feature_bias[NNUE_HIDDEN];
+	int8_t l2_weights[NNUE_L2][2 * NNUE_HIDDEN];
+	int32_t l2_bias[NNUE_L2];
+	int8_t output_weights[NNUE_L2];
+	int32_t output_bias;
+};
+
+// First layer outputs for white's (0) and black's (1) perspectives, which are updated incrementally
+struct NNUEAccumulator
+{
+	int16_t values[2][NNUE_HIDDEN];
+};
+
+// Efficiently updatable neural network evaluation
+class NNUE
+{
+public:
+	// Constructor
+	NNUE(void) noexcept;
+	// Destructor
+	~NNUE(void) noexcept;
+	// Public member functions
+	inline bool is_loaded(void) const noexcept;
+	inline game_rules get_rules(void) const noexcept;
+	inline bool get_misere(void) const noexcept;
+	inline const NNUEWeights& get_weights(void) const noexcept;
+	void set_weights(const NNUEWeights&, game_rules, bool) noexcept; // Sets weights for given rules and game type
+	void load(const std::string&); // Loads weights from given file
+	void load(std::istream&); // Loads weights from given stream in binary format
+	void save(const std::string&) const; // Saves weights to given file
+	void save(std::ostream&) const; // Outputs weights to given stream in binary format
+	// Computes accumulator of board's position from scratch
+	void refresh(NNUEAccumulator&, const Board&) const noexcept;
+	// Incremental accumulator updates when piece of given type is put to or removed from given position
+	inline void add_piece(NNUEAccumulator&, piece_type, Position) const noexcept;
+	inline void remove_piece(NNUEAccumulator&, piece_type, Position) const noexcept;
+	// Returns score of position with given accumulator for given side to move
+	int16_t evaluate(const NNUEAccumulator&, colour) const noexcept;
+	// Index of feature of given piece at given position from given perspective
+	static inline int feature(piece_type, Position, colour) noexcept;
+private:
+	NNUEWeights weights;
+	game_rules rules; // Rules the network was trained for
+	bool misere; // Whether the network was trained for misere games
+	bool loaded;
+};
+
+inline bool NNUE::is_loaded(void) const noexcept
+{
+	return loaded;
+}
+
+inline game_rules NNUE::get_rules(void) const noexcept
+{
+	return rules;
+}
+
+inline bool NNUE::get_misere(void) const noexcept
+{
+	return misere;
+}
+
+inline const NNUEWeights& NNUE::get_weights(void) const noexcept
+{
+	return weights;
+}
+
+inline int NNUE::feature(piece_type pt, Position pos, colour perspective) noexcept
+{
+	// Black's perspective sees the board rotated
+	int sq = (pos.get_row() << 2) + (pos.get_column() >> 1);
+	if (perspective == BLACK)
+		sq = 31 - sq;
+	return ((get_colour(pt) != perspective) << 6) + (is_queen(pt) << 5) + sq;
+}
+
+inline void NNUE::add_piece(NNUEAccumulator& acc, piece_type pt, Position pos) const noexcept
+{
+	for (colour perspective : { WHITE, BLACK })
+	{
+		int16_t* values = acc.values[perspective - WHITE];
+		const int16_t* row = weights.feature_weights[feature(pt, pos, perspective)];
+#if defined NNUE_USE_AVX2
+		for (int i = 0; i < NNUE_HIDDEN; i += 16)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_add_epi16(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i))));
+#elif defined NNUE_USE_SSE2
+		for (int i = 0; i < NNUE_HIDDEN; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_add_epi16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i))));
+#else
+		for (int i = 0; i < NNUE_HIDDEN; ++i)
+			values[i] += row[i];
+#endif
+	}
+}
+
+inline void NNUE::remove_piece(NNUEAccumulator& acc, piece_type pt, Position pos) const noexcept
+{
+	for (colour perspective : { WHITE, BLACK })
+	{
+		int16_t* values = acc.values[perspective - WHITE];
+		const int16_t* row = weights.feature_weights[feature(pt, pos, perspective)];
+#if defined NNUE_USE_AVX2
+		for (int i = 0; i < NNUE_HIDDEN; i += 16)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_sub_epi16(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i))));
+#elif defined NNUE_USE_SSE2
+		for (int i = 0; i < NNUE_HIDDEN; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_sub_epi16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i))));
+#else
+		for (int i = 0; i < NNUE_HIDDEN; ++i)
+			values[i] -= row[i];
+#endif
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,511 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// pdn.cpp, version 1.8
+
+#include "pdn.h"
+#include "misc.h"
+#include <sstream>
+#include <cstring>
+#include <cctype>
+
+namespace
+{
+	constexpr char UTF8_BOM[] = "\xEF\xBB\xBF";
+	constexpr int MAX_PATH_SIZE = 12; // Capacity of Path
+	constexpr size_t LINE_WIDTH = 80; // Maximum width of written movetext lines
+
+	enum char_class : uint8_t { CC_SPACE = 1, CC_DELIMITER = 2, CC_DIGIT = 4 };
+
+	// Classes of characters for scanning
+	struct CharClassTable
+	{
+		uint8_t value[256];
+		constexpr CharClassTable(void)
+			: value()
+		{
+			for (const char* c = " \t\n\r\f\v"; *c != '\0'; ++c)
+				value[static_cast<unsigned char>(*c)] = CC_SPACE | CC_DELIMITER;
+			for (const char* c = "{}()[];"; *c != '\0'; ++c)
+				value[static_cast<unsigned char>(*c)] = CC_DELIMITER;
+			for (int c = '0'; c <= '9'; ++c)
+				value[c] = CC_DIGIT;
+		}
+	};
+
+	constexpr CharClassTable CHAR_CLASS;
+
+	inline bool is_space(char c) noexcept
+	{
+		return (CHAR_CLASS.value[static_cast<unsigned char>(c)] & CC_SPACE) != 0;
+	}
+
+	inline bool is_digit(char c) noexcept
+	{
+		return (CHAR_CLASS.value[static_cast<unsigned char>(c)] & CC_DIGIT) != 0;
+	}
+
+	// Whether given character ends movetext token
+	inline bool is_delimiter(char c) noexcept
+	{
+		return (CHAR_CLASS.value[static_cast<unsigned char>(c)] & CC_DELIMITER) != 0;
+	}
+
+	// Whether text at given pointer is given word followed by a delimiter or the end
+	bool is_word(const char* p, const char* end, const char* word) noexcept
+	{
+		for (; *word != '\0'; ++p, ++word)
+			if (p == end || *p != *word)
+				return false;
+		return p == end || is_delimiter(*p);
+	}
+
+	// Whether text at given pointer is the header of save_game format
+	inline bool is_legacy_header(const char* p, const char* end) noexcept
+	{
+		return is_word(p, end, "DEFAULT_RULES") || is_word(p, end, "ENGLISH_RULES");
+	}
+
+	bool equal_nocase(const TextSpan& span, const char* str) noexcept
+	{
+		const char* p = span.begin;
+		for (; p != span.end && *str != '\0'; ++p, ++str)
+			if (std::tolower(static_cast<unsigned char>(*p)) != *str)
+				return false;
+		return p == span.end && *str == '\0';
+	}
+
+	// Reads given token as game result. Returns false if it isn't a result
+	bool parse_result(const TextSpan& token, game_rules rule, game_state& result) noexcept
+	{
+		// Quick check, since every token of movetext is tested
+		if (token.size() != 1 && token.size() != 3 && token.size() != 7)
+			return false;
+		const game_state white_win = (pdn_white(rule) == WHITE ? WHITE_WIN : BLACK_WIN);
+		const game_state black_win = (pdn_white(rule) == WHITE ? BLACK_WIN : WHITE_WIN);
+		if (token == "2-0" || token == "1-0")
+			result = white_win;
+		else if (token == "0-2" || token == "0-1")
+			result = black_win;
+		else if (token == "1-1" || token == "1/2-1/2")
+			result = DRAW;
+		else if (token == "*" || token == "0-0")
+			result = GAME_CONTINUE;
+		else
+			return false;
+		return true;
+	}
+
+	const char* result_str(game_rules rule, game_state result) noexcept
+	{
+		const bool english = (rule == RULES_ENGLISH);
+		if (result == DRAW)
+			return english ? "1/2-1/2" : "1-1";
+		if (result == GAME_CONTINUE)
+			return "*";
+		if ((result == WHITE_WIN) == (pdn_white(rule) == WHITE))
+			return english ? "1-0" : "2-0";
+		return english ? "0-1" : "0-2";
+	}
+}
+
+std::string TextSpan::str(void) const
+{
+	std::string res;
+	res.reserve(size());
+	for (const char* p = begin; p != end; ++p)
+	{
+		if (*p == '\\' && p + 1 != end)
+			++p;
+		res += *p;
+	}
+	return res;
+}
+
+bool PdnMove::matches(const Move& move) const noexcept
+{
+	const Path& path = move.get_path();
+	if (squares.size() > path.size() || squares.front() != path.front() || squares.back() != path.back())
+		return false;
+	// Intermediate squares should appear in the path in the same order
+	int idx = 1;
+	for (int i = 1; i + 1 < squares.size(); ++i, ++idx)
+	{
+		while (idx + 1 < path.size() && path[idx] != squares[i])
+			++idx;
+		if (idx + 1 >= path.size())
+			return false;
+	}
+	return true;
+}
+
+const TextSpan* PdnGame::find_tag(const char* name) const noexcept
+{
+	for (const auto& tag : tags)
+		if (tag.first == name)
+			return &tag.second;
+	return nullptr;
+}
+
+PdnReader::PdnReader(const char* text, size_t size) noexcept
+	: start(text), cur(text), end(text + size), game_count(0)
+{
+	if (size >= 3 && std::memcmp(text, UTF8_BOM, 3) == 0)
+		cur += 3;
+}
+
+PdnReader::PdnReader(const std::string& file_name)
+	: PdnReader(nullptr, 0)
+{
+	file.open(file_name);
+	start = cur = file.data();
+	end = cur + file.size();
+	if (file.size() >= 3 && std::memcmp(cur, UTF8_BOM, 3) == 0)
+		cur += 3;
+}
+
+bool PdnReader::_skip_space(void) noexcept
+{
+	while (cur != end)
+		if (is_space(*cur))
+			++cur;
+		else if (*cur == '{')
+		{
+			cur = static_cast<const char*>(std::memchr(cur, '}', end - cur));
+			cur = (cur == nullptr ? end : cur + 1);
+		}
+		else if (*cur == ';' || (*cur == '%' && (cur == start || cur[-1] == '\n')))
+		{
+			// Comment or escape line
+			cur = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+			cur = (cur == nullptr ? end : cur + 1);
+		}
+		else
+			return true;
+	return false;
+}
+
+void PdnReader::_skip_game(void) noexcept
+{
+	// Skip to the next line beginning with a tag which follows a non-tag line
+	bool in_tags = true;
+	while (cur != end)
+	{
+		cur = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+		if (cur == nullptr)
+		{
+			cur = end;
+			break;
+		}
+		while (cur != end && is_space(*cur))
+			++cur;
+		if (cur == end)
+			break;
+		if (*cur == '[' || is_legacy_header(cur, end))
+		{
+			if (!in_tags)
+				break;
+		}
+		else
+			in_tags = false;
+	}
+}
+
+void PdnReader::_read_tag(PdnGame& game)
+{
+	const auto skip_blanks = [this] {
+		while (cur != end && is_space(*cur))
+			++cur;
+	};
+	++cur;
+	skip_blanks();
+	const char* name = cur;
+	while (cur != end && !is_space(*cur) && *cur != '"' && *cur != ']')
+		++cur;
+	const TextSpan name_span{ name, cur };
+	skip_blanks();
+	if (name_span.size() == 0 || cur == end || *cur != '"')
+		throw(checkers_error("Tag is malformed"));
+	const char* value = ++cur;
+	for (; cur != end && *cur != '"'; ++cur)
+		if (*cur == '\\' && cur + 1 != end)
+			++cur;
+	if (cur == end)
+		throw(checkers_error("Tag value is not closed"));
+	game.tags.emplace_back(name_span, TextSpan{ value, cur });
+	++cur;
+	skip_blanks();
+	if (cur == end || *cur != ']')
+		throw(checkers_error("Tag is malformed"));
+	++cur;
+}
+
+void PdnReader::_apply_tags(PdnGame& game) const
+{
+	if (const TextSpan* type = game.find_tag("GameType"))
+	{
+		// Only the number is used (it may be followed by board description)
+		int number = 0;
+		for (const char* p = type->begin; p != type->end && is_digit(*p); ++p)
+			number = number * 10 + (*p - '0');
+		if (number == GAME_TYPE_RUSSIAN)
+			game.rules = RULES_DEFAULT;
+		else if (number == GAME_TYPE_ENGLISH)
+			game.rules = RULES_ENGLISH;
+		else
+			throw(checkers_error("Game type " + type->str() + " is not supported"));
+	}
+	if (const TextSpan* variant = game.find_tag("Variant"))
+		game.misere = equal_nocase(*variant, "misere");
+	if (game.find_tag("FEN") != nullptr)
+		throw(checkers_error("Setup positions are not supported"));
+}
+
+void PdnReader::_read_moves(PdnGame& game, bool rules_known)
+{
+	bool result_known = false;
+	while (_skip_space() && *cur != '[' && !is_legacy_header(cur, end))
+	{
+		if (*cur == '(')
+		{
+			// Variation (possibly with nested ones)
+			int level = 0;
+			do
+			{
+				if (*cur == '(')
+					++level;
+				else if (*cur == ')')
+					--level;
+				++cur;
+			} while (level > 0 && _skip_space());
+			continue;
+		}
+		if (*cur == '$')
+		{
+			// Numeric annotation glyph
+			for (++cur; cur != end && is_digit(*cur); ++cur);
+			continue;
+		}
+		const char* token = cur;
+		while (cur != end && !is_delimiter(*cur))
+			++cur;
+		if (token == cur)
+			throw(checkers_error(std::string("Unexpected character ") + *cur));
+		if (parse_result(TextSpan{ token, cur }, game.rules, game.result))
+		{
+			result_known = true;
+			break;
+		}
+		// Move number (which may be followed by a move without space)
+		const char* p = token;
+		while (p != cur && is_digit(*p))
+			++p;
+		if (p != token && p != cur && *p == '.')
+		{
+			while (p != cur && *p == '.')
+				++p;
+			if (p == cur)
+				continue;
+			token = p;
+		}
+		// Move strength marks
+		const char* move_end = cur;
+		while (move_end != token && (move_end[-1] == '!' || move_end[-1] == '?'))
+			--move_end;
+		const bool numeric = is_digit(*token);
+		if (!rules_known)
+			game.rules = (numeric ? RULES_ENGLISH : RULES_DEFAULT), rules_known = true;
+		game.moves.emplace_back();
+		try
+		{
+			parse_move(token, move_end, numeric, game.rules, game.moves.back());
+		}
+		catch (const checkers_error& err)
+		{
+			throw(checkers_error("Error in move " + std::to_string(game.moves.size()) + ": " + err.what()));
+		}
+	}
+	const TextSpan* result = game.find_tag("Result");
+	if (!result_known && result != nullptr)
+		parse_result(*result, game.rules, game.result);
+}
+
+bool PdnReader::next(PdnGame& game)
+{
+	game.rules = RULES_DEFAULT;
+	game.misere = false;
+	game.result = GAME_CONTINUE;
+	game.tags.clear();
+	game.moves.clear();
+	if (!_skip_space())
+		return false;
+	++game_count;
+	try
+	{
+		if (is_legacy_header(cur, end))
+		{
+			// Rules and game type words of save_game format
+			game.rules = (*cur == 'D' ? RULES_DEFAULT : RULES_ENGLISH);
+			cur += std::strlen("DEFAULT_RULES");
+			_skip_space();
+			if (is_word(cur, end, "MISERE_GAME"))
+				game.misere = true;
+			else if (!is_word(cur, end, "NORMAL_GAME"))
+				throw(checkers_error("Game type should be either NORMAL_GAME or MISERE_GAME"));
+			cur += std::strlen("NORMAL_GAME");
+			_read_moves(game, true);
+		}
+		else
+		{
+			while (_skip_space() && *cur == '[')
+				_read_tag(game);
+			_apply_tags(game);
+			_read_moves(game, game.find_tag("GameType") != nullptr);
+		}
+	}
+	catch (const checkers_error&)
+	{
+		_skip_game();
+		throw;
+	}
+	return true;
+}
+
+void PdnReader::parse_move(const char* begin, const char* end, bool numeric, game_rules rule, PdnMove& move)
+{
+	move.squares.clear();
+	move.capture = false;
+	for (const char* p = begin; ; ++p)
+	{
+		const int cur_pos = move.squares.size() + 1;
+		Position pos;
+		if (numeric)
+		{
+			int number = 0;
+			const char* start = p;
+			for (; p != end && is_digit(*p) && p - start < 2; ++p)
+				number = number * 10 + (*p - '0');
+			if (p == start)
+				throw(checkers_error("Move has wrong format"));
+			if (number < 1 || number > 32)
+				throw(checkers_error("Position " + std::to_string(cur_pos) + ": Position is illegal"));
+			pos = pdn_position(rule, number);
+		}
+		else
+		{
+			if (end - p < 2)
+				throw(checkers_error("Move has wrong format"));
+			const int col = p[0] - 'a', row = p[1] - '1';
+			if (row < 0 || row > 7 || col < 0 || col > 7 || (row & 1) != (col & 1))
+				throw(checkers_error("Position " + std::to_string(cur_pos) + ": Position is illegal"));
+			pos = Position(row, col);
+			p += 2;
+		}
+		if (move.squares.size() == MAX_PATH_SIZE)
+			throw(checkers_error("Move is too long"));
+		move.squares.add(pos);
+		if (p == end)
+			break;
+		if (*p == 'x' || *p == ':')
+			move.capture = true;
+		else if (*p != '-')
+			throw(checkers_error("Move has wrong format"));
+	}
+	if (move.squares.size() == 1)
+		throw(checkers_error("Move cannot consist of only one position"));
+}
+
+// Squares are numbered from the side of the player who moves second, from left to right as he sees the board
+int pdn_square(game_rules rule, Position pos) noexcept
+{
+	if (rule == RULES_ENGLISH)
+		return (pos.get_row() << 2) + 4 - (pos.get_column() >> 1);
+	return ((7 - pos.get_row()) << 2) + (pos.get_column() >> 1) + 1;
+}
+
+Position pdn_position(game_rules rule, int square) noexcept
+{
+	const int idx = square - 1;
+	if (rule == RULES_ENGLISH)
+	{
+		const int row = idx >> 2;
+		return Position(row, ((3 - (idx & 3)) << 1) + (row & 1));
+	}
+	const int row = 7 - (idx >> 2);
+	return Position(row, ((idx & 3) << 1) + (row & 1));
+}
+
+void write_pdn_move(std::ostream& ostr, game_rules rule, const Move& move)
+{
+	if (rule != RULES_ENGLISH)
+	{
+		Board::write_move(ostr, move);
+		return;
+	}
+	const char delim = (move.capt_size() == 0 ? '-' : 'x');
+	for (int i = 0; i < move.size(); ++i)
+	{
+		if (i != 0)
+			ostr << delim;
+		ostr << pdn_square(rule, move[i]);
+	}
+}
+
+void write_pdn(std::ostream& ostr, game_rules rule, bool mis, const std::vector<Move>& moves, game_state result,
+	const std::vector<std::pair<std::string, std::string>>& tags)
+{
+	for (const auto& tag : tags)
+	{
+		if (tag.first == "GameType" || tag.first == "Variant" || tag.first == "Result")
+			continue;
+		ostr << '[' << tag.first << " \"";
+		for (char c : tag.second)
+			ostr << (c == '"' || c == '\\' ? "\\" : "") << c;
+		ostr << "\"]\n";
+	}
+	ostr << "[GameType \"" << (rule == RULES_ENGLISH ? PdnReader::GAME_TYPE_ENGLISH : PdnReader::GAME_TYPE_RUSSIAN) << "\"]\n";
+	if (mis)
+		ostr << "[Variant \"Misere\"]\n";
+	ostr << "[Result \"" << result_str(rule, result) << "\"]\n\n";
+	// Movetext (move number stays on the same line with its move)
+	std::string line;
+	std::ostringstream token;
+	const auto put = [&ostr, &line](const std::string& str) {
+		if (!line.empty() && line.size() + 1 + str.size() > LINE_WIDTH)
+		{
+			ostr << line << '\n';
+			line.clear();
+		}
+		if (!line.empty())
+			line += ' ';
+		line += str;
+	};
+	for (size_t i = 0; i < moves.size(); ++i)
+	{
+		token.str("");
+		if (i % 2 == 0)
+			token << i / 2 + 1 << ". ";
+		write_pdn_move(token, rule, moves[i]);
+		put(token.str());
+	}
+	put(result_str(rule, result));
+	ostr << line << "\n\n";
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// pdn.h, version 1.8
+
+#pragma once
+#ifndef _PDN_H
+#define _PDN_H
+#include <string>
+#include <vector>
+#include <iostream>
+#include "board.h"
+#include "mapped_file.h"
+
+// Piece of text inside data which is being parsed (valid while the data is)
+struct TextSpan
+{
+	const char* begin;
+	const char* end;
+	inline size_t size(void) const noexcept;
+	inline bool operator==(const char*) const noexcept;
+	std::string str(void) const; // Copy of the text with PDN escapes (\" and \\) resolved
+};
+
+// Move as written in PDN. Captures may be written by their first and last squares only
+struct PdnMove
+{
+	Path squares;
+	bool capture;
+	// Whether given legal move is described by this one (the written squares are its path or a part of it
+	// with the same first and last squares)
+	bool matches(const Move&) const noexcept;
+};
+
+// Game read from PDN or from the text format of save_game (which is read as PDN without tags)
+struct PdnGame
+{
+	game_rules rules;
+	bool misere;
+	game_state result; // GAME_CONTINUE if the result is unknown
+	std::vector<std::pair<TextSpan, TextSpan>> tags; // Names and values (with escapes) in order of appearance
+	std::vector<PdnMove> moves;
+	const TextSpan* find_tag(const char*) const noexcept; // Returns value of given tag or nullptr if it is absent
+};
+
+// Streaming PDN (Portable Draughts Notation) parser. It works directly on text in memory (a memory-mapped
+// file or given buffer) without copying it and reuses storage of the game, so big collections are read at
+// disk speed. Tags, move numbers, algebraic and numeric moves (including short notation of captures),
+// comments, NAGs, move strength marks and variations (which are skipped) are supported. GameType 25
+// (russian draughts) and 21 (english checkers) are read, and when it's absent, notation of the first move
+// decides (algebraic is russian, numeric is english). Setup positions (FEN tag) aren't supported.
+// In english checkers the first player is black, so PDN colours (in results) are swapped for engine's ones
+class PdnReader
+{
+public:
+	static constexpr int GAME_TYPE_RUSSIAN = 25;
+	static constexpr int GAME_TYPE_ENGLISH = 21;
+	// Constructors
+	PdnReader(const char*, size_t) noexcept; // Given text should outlive the reader and its games
+	explicit PdnReader(const std::string&); // Maps given file
+	// Public member functions
+	inline uint64_t get_game_count(void) const noexcept; // Count of games which were read (including erroneous)
+	// Reads the next game. Returns false if there are no more games. On error throws checkers_error
+	// and skips to the next game, so reading can be continued
+	bool next(PdnGame&);
+	// Parses move from given text with given notation
+	static void parse_move(const char*, const char*, bool, game_rules, PdnMove&);
+private:
+	bool _skip_space(void) noexcept; // Skips spaces and comments. Returns false at the end of text
+	void _skip_game(void) noexcept; // Skips to the next tag section
+	void _read_tag(PdnGame&);
+	void _apply_tags(PdnGame&) const;
+	void _read_moves(PdnGame&, bool); // Reads movetext (the flag tells whether rules are known from the header)
+	MappedFile file;
+	const char* start; // Beginning of the text
+	const char* cur;
+	const char* end;
+	uint64_t game_count;
+};
+
+// Colour of PDN's white player (it moves second in english checkers, so it is engine's black there)
+inline colour pdn_white(game_rules) noexcept;
+// Number (1-32) of square of given position in numeric notation for given rules
+int pdn_square(game_rules, Position) noexcept;
+// Position of given square in numeric notation for given rules
+Position pdn_position(game_rules, int) noexcept;
+// Outputs given move in notation of given rules (algebraic for russian and numeric for english)
+void write_pdn_move(std::ostream&, game_rules, const Move&);
+// Outputs game with given rules, moves, result and tags in PDN (GameType and Result tags are written by it)
+void write_pdn(std::ostream&, game_rules, bool, const std::vector<Move>&, game_state,
+	const std::vector<std::pair<std::string, std::string>>& = {});
+
+inline size_t TextSpan::size(void) const noexcept
+{
+	return end - begin;
+}
+
+inline bool TextSpan::operator==(const char* str) const noexcept
+{
+	const char* p = begin;
+	for (; p != end && *str != '\0'; ++p, ++str)
+		if (*p != *str)
+			return false;
+	return p == end && *str == '\0';
+}
+
+inline colour pdn_white(game_rules rule) noexcept
+{
+	return rule == RULES_ENGLISH ? BLACK : WHITE;
+}
+
+inline uint64_t PdnReader::get_game_count(void) const noexcept
+{
+	return game_count;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// search_params.cpp, version 1.8
+
+#include "search_params.h"
+#include "misc.h"
+#include <fstream>
+#include <algorithm>
+
+const SearchParamInfo SEARCH_PARAM_INFO[SEARCH_PARAM_COUNT] = {
+	{ "lmr_min_depth", 4, 4, 12, 1 }, // Not less than the largest late move reduction
+	{ "mc_moves_check", 5, 1, 12, 1 },
+	{ "mc_moves_prune", 3, 1, 12, 1 },
+	{ "mc_reduction", 3, 1, 8, 1 },
+	{ "mc_min_depth", 6, 2, 16, 1 },
+	{ "etc_min_depth", 4, 1, 12, 1 },
+	{ "pbcut_depth_reduction", 4, 1, 8, 1 },
+	{ "pbcut_min_depth", 8, 4, 20, 1 },
+	{ "pbcut_margin", 120, 0, 500, 15 },
+	{ "delta_pruning_margin", 300, 0, 1000, 25 },
+	{ "lt_pruning_margin", 265, 0, 1000, 25 },
+	{ "stand_pat_margin", 300, 0, 1000, 25 },
+	{ "futility_margin", 300, 0, 1000, 25 },
+	{ "aspiration_delta", 24, 1, 200, 4 }
+};
+
+SearchParams::SearchParams(void) noexcept
+{
+	for (int i = 0; i < SEARCH_PARAM_COUNT; ++i)
+		value[i] = SEARCH_PARAM_INFO[i].default_value;
+}
+
+void SearchParams::set(search_param param, int val) noexcept
+{
+	value[param] = std::min(std::max(val, SEARCH_PARAM_INFO[param].min_value), SEARCH_PARAM_INFO[param].max_value);
+	// Reduced searches of multi-cut and prob cut should have positive depth, so minimum depths follow reductions
+	value[SP_MC_MIN_DEPTH] = std::max(value[SP_MC_MIN_DEPTH], value[SP_MC_REDUCTION] + 2);
+	value[SP_PBCUT_MIN_DEPTH] = std::max(value[SP_PBCUT_MIN_DEPTH], value[SP_PBCUT_DEPTH_REDUCTION] + 1);
+}
+
+search_param SearchParams::find(const std::string& name) noexcept
+{
+	for (int i = 0; i < SEARCH_PARAM_COUNT; ++i)
+		if (name == SEARCH_PARAM_INFO[i].name)
+			return static_cast<search_param>(i);
+	return SEARCH_PARAM_COUNT;
+}
+
+void SearchParams::load(const std::string& file_name)
+{
+	std::ifstream in(file_name);
+	if (!in)
+		throw(checkers_error("Unable to open search parameters file " + file_name));
+	load(in);
+}
+
+void SearchParams::load(std::istream& istr)
+{
+	SearchParams loaded;
+	std::string name;
+	int val;
+	while (istr >> name)
+	{
+		const search_param param = find(name);
+		if (param == SEARCH_PARAM_COUNT)
+			throw(checkers_error("Unknown search parameter " + name));
+		if (!(istr >> val))
+			throw(checkers_error("Wrong value of search parameter " + name));
+		loaded.set(param, val);
+	}
+	*this = loaded;
+}
+
+void SearchParams::save(const std::string& file_name) const
+{
+	std::ofstream out(file_name);
+	if (!out)
+		throw(checkers_error("Unable to create search parameters file " + file_name));
+	save(out);
+}
+
+void SearchParams::save(std::ostream& ostr) const
+{
+	for (int i = 0; i < SEARCH_PARAM_COUNT; ++i)
+		ostr << SEARCH_PARAM_INFO[i].name << ' ' << value[i] << '\n';
+}
\ No newline at end of file
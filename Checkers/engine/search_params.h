@@ -0,0 +1,85 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// search_params.h, version 1.8
+
+#pragma once
+#ifndef _SEARCH_PARAMS_H
+#define _SEARCH_PARAMS_H
+#include <string>
+#include <iostream>
+
+// Indices of search parameters (pruning, reduction and aspiration window settings)
+enum search_param : int {
+	SP_LMR_MIN_DEPTH, // Minimum search depth where late move reduction can be applied
+	SP_MC_MOVES_CHECK, // Count of moves to check in multi-cut pruning
+	SP_MC_MOVES_PRUNE, // Count of moves to prune in multi-cut pruning
+	SP_MC_REDUCTION, // Reduction of depth in multi-cut pruning
+	SP_MC_MIN_DEPTH, // Minimum depth where multi-cut pruning is applied
+	SP_ETC_MIN_DEPTH, // Minimum search depth where enhanced transposition cutoff can be applied
+	SP_PBCUT_DEPTH_REDUCTION, // Reduction of depth for prob cut
+	SP_PBCUT_MIN_DEPTH, // Minimum search depth where prob cut can be applied
+	SP_PBCUT_MARGIN, // Margin of prob cut bound (it is decreased by depth)
+	SP_DELTA_PRUNING_MARGIN, // Safety margin for delta pruning in quiscence search
+	SP_LT_PRUNING_MARGIN, // Safety margin for LT pruning
+	SP_STAND_PAT_MARGIN, // Safety margin for stand-pat pruning
+	SP_FUTILITY_MARGIN, // Futility pruning margin
+	SP_ASPIRATION_DELTA, // Initial half-width of aspiration window
+	SEARCH_PARAM_COUNT
+};
+
+// Description of search parameter in the registry
+struct SearchParamInfo
+{
+	const char* name; // Name in text format
+	int default_value; // Default value
+	int min_value; // Minimum allowed value
+	int max_value; // Maximum allowed value
+	int step; // Typical change of value (perturbation size for tuning)
+};
+
+// Registry of search parameters (indexed by search_param)
+extern const SearchParamInfo SEARCH_PARAM_INFO[SEARCH_PARAM_COUNT];
+
+// Parameter set of search, which can be changed at runtime (e.g. by tuning)
+struct SearchParams
+{
+	int value[SEARCH_PARAM_COUNT]; // Parameter values
+	// Constructor. Sets default parameters
+	SearchParams(void) noexcept;
+	inline int operator[](search_param) const noexcept;
+	// Sets given parameter to given value clamped to its allowed range (minimum depths of multi-cut
+	// and prob cut are raised if needed, so that their reduced searches keep positive depth)
+	void set(search_param, int) noexcept;
+	// Returns index of parameter with given name (SEARCH_PARAM_COUNT if there is no such parameter)
+	static search_param find(const std::string&) noexcept;
+	void load(const std::string&); // Loads parameters from given file
+	void load(std::istream&); // Loads parameters from given stream in text format
+	void save(const std::string&) const; // Saves parameters to given file
+	void save(std::ostream&) const; // Outputs parameters to given stream in text format
+};
+
+inline int SearchParams::operator[](search_param param) const noexcept
+{
+	return value[param];
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// search_pool.cpp, version 1.8
+
+#include "search_pool.h"
+#include "misc.h"
+#include "large_memory.h"
+
+GameBoard::GameBoard(game_rules rules, bool misere)
+	: Board(rules)
+{
+	restart(rules, misere);
+}
+
+void GameBoard::restart(game_rules rule, bool mis) noexcept
+{
+	Board::restart(rule, mis);
+	moves.clear();
+}
+
+bool GameBoard::move(Move& m)
+{
+	if (state != GAME_CONTINUE || !legal_move(m))
+		return false;
+	_do_move(m);
+	_proceed(m);
+	_update_game_state();
+	moves.push_back(m);
+	return true;
+}
+
+// Board keeps no undo information, so the remaining moves are replayed
+void GameBoard::undo_moves(size_t count)
+{
+	std::vector<Move> played;
+	played.swap(moves);
+	played.resize(played.size() - std::min(count, played.size()));
+	restart(rules, misere);
+	for (Move& m : played)
+		move(m);
+}
+
+SearchPool::SearchPool(int worker_count, size_t hash_size)
+	: stopping(false)
+{
+	for (int i = 0; i < std::max(worker_count, 1); ++i)
+	{
+		workers.push_back(std::make_unique<Worker>());
+		Worker& worker = *workers.back();
+		worker.engine = std::make_unique<Checkers>();
+		if (hash_size != 0)
+			worker.engine->set_hash_size(hash_size);
+		worker.game = 0;
+		worker.busy = false;
+	}
+	// Threads are started after all engines are created, since creation may throw
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i]->thread = std::thread(&SearchPool::_run, this, std::ref(*workers[i]), int(i));
+}
+
+SearchPool::~SearchPool(void) noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		queue.clear();
+		for (auto& worker : workers)
+			worker->engine->request_stop();
+	}
+	task_cv.notify_all();
+	for (auto& worker : workers)
+		worker->thread.join();
+}
+
+void SearchPool::configure(const std::function<void(Checkers&)>& function)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& worker : workers)
+		function(*worker->engine);
+}
+
+void SearchPool::submit(SearchTask task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(std::move(task));
+	}
+	task_cv.notify_one();
+}
+
+void SearchPool::cancel(uint64_t game)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto it = queue.begin(); it != queue.end(); )
+		if (it->game == game)
+			it = queue.erase(it);
+		else
+			++it;
+	for (auto& worker : workers)
+		if (worker->busy && worker->game == game)
+			worker->engine->request_stop();
+}
+
+void SearchPool::_run(Worker& worker, int index)
+{
+	// Workers are spread across NUMA nodes. Transposition tables are allocated by the first search,
+	// so they are placed on the node of their worker
+	bind_thread_to_node(index);
+	Checkers& engine = *worker.engine;
+	for (;;)
+	{
+		SearchTask task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			task_cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+			if (stopping)
+				return;
+			// Next task of the previous game finds useful entries in this worker's transposition tables
+			auto chosen = queue.begin();
+			for (auto it = queue.begin(); it != queue.end() && size_t(it - queue.begin()) < AFFINITY_WINDOW; ++it)
+				if (it->game == worker.game)
+				{
+					chosen = it;
+					break;
+				}
+			task = std::move(*chosen);
+			queue.erase(chosen);
+			worker.game = task.game;
+			worker.busy = true;
+			engine.reset_stop(); // Under the lock, so that cancel of this task isn't lost
+		}
+		SearchResult result = { Move(), 0, 0 };
+		try
+		{
+			engine.set_game(task.rules, task.misere, task.moves);
+			engine.set_search_depth(task.depth);
+			engine.set_time_limit(task.time_limit);
+			engine.set_node_limit(task.node_limit);
+			result.depth = engine.get_computer_move(result.move, result.score);
+		}
+		catch (const checkers_error&)
+		{
+			// Game with illegal moves is reported as having no move
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			worker.busy = false;
+		}
+		if (task.on_finish)
+			task.on_finish(result);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// search_pool.h, version 1.8
+
+#pragma once
+#ifndef _SEARCH_POOL_H
+#define _SEARCH_POOL_H
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include "async_search.h"
+
+// Lightweight state of a game which is searched by SearchPool workers. It only validates and records moves,
+// so it is much smaller than Checkers (which has transposition tables and search heuristics)
+class GameBoard
+	: public Board
+{
+public:
+	// Constructor
+	GameBoard(game_rules = RULES_DEFAULT, bool = false);
+	// Public member functions
+	void restart(game_rules = RULES_DEFAULT, bool = false) noexcept override;
+	bool move(Move&); // Plays given move if it is legal (its information is filled then)
+	void undo_moves(size_t); // Takes back given count of the last moves
+	inline colour current_turn_colour(void) const noexcept;
+	inline const std::vector<Move>& get_moves(void) const noexcept; // Moves of the game
+private:
+	std::vector<Move> moves;
+};
+
+// Request of search in a game's position
+struct SearchTask
+{
+	uint64_t game; // Identifier of the game (for cancelling and for giving the game to the same worker)
+	game_rules rules;
+	bool misere;
+	std::vector<Move> moves; // Moves of the game from the initial position
+	int8_t depth;
+	float time_limit;
+	uint64_t node_limit;
+	std::function<void(const SearchResult&)> on_finish; // Receives the result in the worker thread
+};
+
+// Fixed set of worker threads with their own engines, which serve searches of many games. Memory doesn't depend
+// on count of games, and transposition tables of each worker are kept across tasks (so games share them).
+// Tasks are served in order of submission, but a worker prefers the next task of the game it has just searched
+class SearchPool
+{
+public:
+	static constexpr size_t AFFINITY_WINDOW = 8; // Count of queued tasks examined for the worker's previous game
+	// Constructor. Creates given count of workers with given size of transposition tables (MB, 0 means default)
+	SearchPool(int, size_t = 0);
+	// Destructor. Drops queued tasks and waits for running ones
+	~SearchPool(void) noexcept;
+	// Public member functions
+	inline int get_worker_count(void) const noexcept;
+	// Calls given function for engine of each worker (e.g. to set its resources). Should be called while idle
+	void configure(const std::function<void(Checkers&)>&);
+	void submit(SearchTask); // Queues given task
+	void cancel(uint64_t); // Drops queued tasks of given game and stops its running search (result is still reported)
+private:
+	struct Worker
+	{
+		std::unique_ptr<Checkers> engine;
+		std::thread thread;
+		uint64_t game; // Game of the current or the last task
+		bool busy;
+	};
+	void _run(Worker&, int); // Serves tasks by given worker with given index
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::deque<SearchTask> queue;
+	std::mutex mutex;
+	std::condition_variable task_cv;
+	bool stopping;
+};
+
+inline colour GameBoard::current_turn_colour(void) const noexcept
+{
+	return white_turn ? WHITE : BLACK;
+}
+
+inline const std::vector<Move>& GameBoard::get_moves(void) const noexcept
+{
+	return moves;
+}
+
+inline int SearchPool::get_worker_count(void) const noexcept
+{
+	return int(workers.size());
+}
+
+#endif
\ No newline at end of file
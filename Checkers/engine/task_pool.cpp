@@ -0,0 +1,117 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// task_pool.cpp, version 1.8
+
+#include "task_pool.h"
+#include "large_memory.h"
+
+TaskPool::TaskPool(int count)
+	: queued(0), pending(0), next_queue(0), stopping(false)
+{
+	for (int i = 0; i < count; ++i)
+		queues.push_back(std::make_unique<Queue>());
+	for (int i = 0; i < count; ++i)
+		threads.emplace_back(&TaskPool::_run, this, i);
+}
+
+TaskPool::~TaskPool(void) noexcept
+{
+	wait();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	task_cv.notify_all();
+	for (auto& thread : threads)
+		thread.join();
+}
+
+void TaskPool::submit(Task task)
+{
+	size_t idx;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		idx = next_queue;
+		next_queue = (next_queue + 1) % queues.size();
+	}
+	{
+		// The task is queued before it is counted, so a reserved task is always present in some queue
+		std::lock_guard<std::mutex> lock(queues[idx]->mutex);
+		queues[idx]->tasks.push_back(std::move(task));
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		++queued;
+		++pending;
+	}
+	task_cv.notify_one();
+}
+
+void TaskPool::wait(void)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	done_cv.wait(lock, [this] { return pending == 0; });
+}
+
+TaskPool::Task TaskPool::_take(int worker)
+{
+	for (;;)
+		for (size_t i = 0; i < queues.size(); ++i)
+		{
+			Queue& queue = *queues[(worker + i) % queues.size()];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.tasks.empty())
+				continue;
+			Task task;
+			if (i == 0)
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+			else
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			}
+			return task;
+		}
+}
+
+void TaskPool::_run(int worker)
+{
+	// Workers are spread across NUMA nodes, so that memory of their engines is local to them
+	bind_thread_to_node(worker);
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			task_cv.wait(lock, [this] { return stopping || queued > 0; });
+			if (queued == 0)
+				return;
+			--queued;
+		}
+		_take(worker)(worker);
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--pending == 0)
+			done_cv.notify_all();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// task_pool.h, version 1.8
+
+#pragma once
+#ifndef _TASK_POOL_H
+#define _TASK_POOL_H
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <deque>
+
+// Fixed set of threads which run independent tasks (e.g. searches of positions by per-worker engines).
+// Every worker has its own queue which is filled round-robin and served from the front. A worker whose
+// queue is empty steals from the back of other queues, so uneven tasks don't leave cores idle
+class TaskPool
+{
+public:
+	using Task = std::function<void(int)>; // Receives index of the worker which runs it. Shouldn't throw
+	// Constructor. Creates given count of workers
+	explicit TaskPool(int);
+	// Destructor. Finishes all submitted tasks
+	~TaskPool(void) noexcept;
+	// Public member functions
+	inline int get_worker_count(void) const noexcept;
+	inline size_t get_pending(void) noexcept; // Count of submitted tasks which aren't finished yet
+	void submit(Task); // Queues given task
+	void wait(void); // Waits until all submitted tasks are finished
+private:
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+	void _run(int);
+	Task _take(int); // Takes a task reserved by the worker from its own queue or from other ones
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> threads;
+	std::mutex mutex; // Guards the counters below
+	std::condition_variable task_cv, done_cv;
+	size_t queued; // Count of queued tasks which aren't reserved by workers
+	size_t pending;
+	size_t next_queue; // Queue which receives the next task
+	bool stopping;
+};
+
+inline int TaskPool::get_worker_count(void) const noexcept
+{
+	return int(threads.size());
+}
+
+inline size_t TaskPool::get_pending(void) noexcept
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return pending;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// training_data.cpp, version 1.8
+
+#include "training_data.h"
+#include "misc.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	constexpr char TD_MAGIC[8] = { 'C', 'H', 'K', 'R', 'S', 'T', 'D', '1' };
+}
+
+void TrainingRecord::set(const Board& board, colour turn, int16_t sc, int8_t res) noexcept
+{
+	white = black = queens = 0;
+	for (int sq = 0; sq < 32; ++sq)
+	{
+		const Piece cur = board.get_cell(square_position(sq));
+		const uint32_t bit = uint32_t(1) << sq;
+		if (cur.get_colour() == WHITE)
+			white |= bit;
+		else if (cur.get_colour() == BLACK)
+			black |= bit;
+		if (cur.is_queen())
+			queens |= bit;
+	}
+	score = sc;
+	result = res;
+	flags = (turn == BLACK ? TRF_BLACK_TURN : 0) | (board.get_rules() == RULES_ENGLISH ? TRF_ENGLISH : 0)
+		| (board.get_misere() ? TRF_MISERE : 0);
+}
+
+TrainingDataWriter::TrainingDataWriter(const std::string& file_name, bool append)
+	: count(0)
+{
+	std::ifstream existing(file_name, std::ios::binary);
+	const bool has_header = (append && existing && existing.peek() != std::ifstream::traits_type::eof());
+	existing.close();
+	out.open(file_name, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+	if (!out)
+		throw(checkers_error("Unable to create training data file " + file_name));
+	if (!has_header)
+		out.write(TD_MAGIC, sizeof(TD_MAGIC));
+}
+
+TrainingDataWriter::~TrainingDataWriter(void) noexcept = default;
+
+void TrainingDataWriter::write(const TrainingRecord* records, size_t cnt)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	out.write(reinterpret_cast<const char*>(records), cnt * sizeof(TrainingRecord));
+	if (!out)
+		throw(checkers_error("Unable to write training data"));
+	count += cnt;
+}
+
+TrainingDataReader::TrainingDataReader(const std::string& file_name)
+	: in(file_name, std::ios::binary), buffer_pos(0)
+{
+	char magic[sizeof(TD_MAGIC)];
+	if (!in)
+		throw(checkers_error("Unable to open training data file " + file_name));
+	if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, TD_MAGIC, sizeof(magic)) != 0)
+		throw(checkers_error("Training data has wrong format"));
+}
+
+TrainingDataReader::~TrainingDataReader(void) noexcept = default;
+
+size_t TrainingDataReader::read(TrainingRecord* records, size_t cnt)
+{
+	size_t done = 0;
+	while (done < cnt)
+	{
+		if (buffer_pos == buffer.size())
+		{
+			// Refill the buffer
+			buffer.resize(BUFFER_SIZE);
+			in.read(reinterpret_cast<char*>(buffer.data()), BUFFER_SIZE * sizeof(TrainingRecord));
+			buffer.resize(size_t(in.gcount()) / sizeof(TrainingRecord));
+			buffer_pos = 0;
+			if (buffer.empty())
+				break;
+		}
+		const size_t chunk = std::min(cnt - done, buffer.size() - buffer_pos);
+		std::memcpy(records + done, buffer.data() + buffer_pos, chunk * sizeof(TrainingRecord));
+		done += chunk, buffer_pos += chunk;
+	}
+	return done;
+}
\ No newline at end of file
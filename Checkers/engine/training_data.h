@@ -0,0 +1,134 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// training_data.h, version 1.8
+
+#pragma once
+#ifndef _TRAINING_DATA_H
+#define _TRAINING_DATA_H
+#include <string>
+#include <fstream>
+#include <mutex>
+#include <vector>
+#include "board.h"
+
+// Position labelled with search score and game result. Playable squares are numbered
+// row * 4 + column / 2 (as in Bitbase), bit i of masks corresponds to square i
+struct TrainingRecord
+{
+	uint32_t white; // Squares of white pieces
+	uint32_t black; // Squares of black pieces
+	uint32_t queens; // Squares of queens of both colours
+	int16_t score; // Search score for side to move
+	int8_t result; // Game result for side to move (1 - win, 0 - draw, -1 - loss)
+	uint8_t flags; // TRF_* flags
+
+	static constexpr uint8_t TRF_BLACK_TURN = 1; // Black is to move
+	static constexpr uint8_t TRF_ENGLISH = 2; // Position is from a game with english rules
+	static constexpr uint8_t TRF_MISERE = 4; // Position is from a misere game
+
+	// Fills record with board's position (with given colour to move) and given labels
+	void set(const Board&, colour, int16_t, int8_t) noexcept;
+	inline colour turn(void) const noexcept;
+	inline game_rules rules(void) const noexcept;
+	inline bool misere(void) const noexcept;
+	// Returns piece at given playable square
+	inline Piece piece(int) const noexcept;
+	// Returns position of given playable square
+	static inline Position square_position(int) noexcept;
+};
+
+static_assert(sizeof(TrainingRecord) == 16, "Training record should be 16 bytes");
+
+// Appends records to a binary training data file. Writing is thread-safe
+class TrainingDataWriter
+{
+public:
+	// Constructor. Creates (or, optionally, appends to) given file
+	TrainingDataWriter(const std::string&, bool = false);
+	// Destructor
+	~TrainingDataWriter(void) noexcept;
+	// Public member functions
+	void write(const TrainingRecord*, size_t); // Appends given records
+	inline uint64_t get_count(void) const noexcept; // Count of records written by this writer
+private:
+	std::ofstream out;
+	std::mutex mutex;
+	uint64_t count;
+};
+
+// Reads records of binary training data file sequentially
+class TrainingDataReader
+{
+public:
+	static constexpr size_t BUFFER_SIZE = 1 << 16; // Count of records read from file at once
+	// Constructor. Opens given file
+	TrainingDataReader(const std::string&);
+	// Destructor
+	~TrainingDataReader(void) noexcept;
+	// Reads next record. Returns false at the end of data
+	inline bool next(TrainingRecord&);
+	// Reads up to given count of records to given array. Returns count of read records
+	size_t read(TrainingRecord*, size_t);
+private:
+	std::ifstream in;
+	std::vector<TrainingRecord> buffer;
+	size_t buffer_pos;
+};
+
+inline colour TrainingRecord::turn(void) const noexcept
+{
+	return (flags & TRF_BLACK_TURN) ? BLACK : WHITE;
+}
+
+inline game_rules TrainingRecord::rules(void) const noexcept
+{
+	return (flags & TRF_ENGLISH) ? RULES_ENGLISH : RULES_DEFAULT;
+}
+
+inline bool TrainingRecord::misere(void) const noexcept
+{
+	return (flags & TRF_MISERE) != 0;
+}
+
+inline Piece TrainingRecord::piece(int sq) const noexcept
+{
+	const uint32_t bit = uint32_t(1) << sq;
+	return Piece((white & bit) ? WHITE : (black & bit) ? BLACK : EMPTY, (queens & bit) != 0);
+}
+
+inline Position TrainingRecord::square_position(int sq) noexcept
+{
+	const int row = sq >> 2;
+	return Position(row, ((sq & 3) << 1) + (row & 1));
+}
+
+inline uint64_t TrainingDataWriter::get_count(void) const noexcept
+{
+	return count;
+}
+
+inline bool TrainingDataReader::next(TrainingRecord& record)
+{
+	return read(&record, 1) == 1;
+}
+
+#endif
\ No newline at end of file
@@ -1,40 +1,40 @@
-//{{NO_DEPENDENCIES}}
-//  ,   Microsoft Visual C++.
-//  Checkers.rc
-//
-#define IDC_MYICON                      2
-#define IDD_NEWGAME                     102
-#define IDD_ABOUTBOX                    103
-#define IDM_ABOUT                       104
-#define IDM_EXIT                        105
-#define IDC_CHECKERS                    110
-#define IDM_NEW_GAME                    111
-#define IDM_REVERSE                     113
-#define IDM_UNDO_MOVE                   114
-#define IDM_REDO_MOVE                   115
-#define IDM_HINT                        116
-#define IDM_OPENGAME                    117
-#define IDM_SAVEGAME                    118
-#define IDM_OPENBOARD                   119
-#define IDM_SAVEBOARD                   120
-#define IDR_MAINFRAME                   140
-#define IDC_WHITE                       1000
-#define IDC_BLACK                       1001
-#define IDC_LEVEL                       1002
-#define IDC_PVP                         1003
-#define IDC_MISERE                      1004
-#define IDC_RULES                       1005
-#define IDC_TIMELIMIT                   1006
-#define IDC_STATIC                      -1
-
-// Next default values for new objects
-// 
-#ifdef APSTUDIO_INVOKED
-#ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NO_MFC                     1
-#define _APS_NEXT_RESOURCE_VALUE        141
-#define _APS_NEXT_COMMAND_VALUE         32794
-#define _APS_NEXT_CONTROL_VALUE         1007
-#define _APS_NEXT_SYMED_VALUE           110
-#endif
-#endif
+//{{NO_DEPENDENCIES}}
+//  ,   Microsoft Visual C++.
+//  Checkers.rc
+//
+#define IDC_MYICON                      2
+#define IDD_NEWGAME                     102
+#define IDD_ABOUTBOX                    103
+#define IDM_ABOUT                       104
+#define IDM_EXIT                        105
+#define IDC_CHECKERS                    110
+#define IDM_NEW_GAME                    111
+#define IDM_REVERSE                     113
+#define IDM_UNDO_MOVE                   114
+#define IDM_REDO_MOVE                   115
+#define IDM_HINT                        116
+#define IDM_OPENGAME                    117
+#define IDM_SAVEGAME                    118
+#define IDM_OPENBOARD                   119
+#define IDM_SAVEBOARD                   120
+#define IDR_MAINFRAME                   140
+#define IDC_WHITE                       1000
+#define IDC_BLACK                       1001
+#define IDC_LEVEL                       1002
+#define IDC_PVP                         1003
+#define IDC_MISERE                      1004
+#define IDC_RULES                       1005
+#define IDC_TIMELIMIT                   1006
+#define IDC_STATIC                      -1
+
+// Next default values for new objects
+// 
+#ifdef APSTUDIO_INVOKED
+#ifndef APSTUDIO_READONLY_SYMBOLS
+#define _APS_NO_MFC                     1
+#define _APS_NEXT_RESOURCE_VALUE        141
+#define _APS_NEXT_COMMAND_VALUE         32794
+#define _APS_NEXT_CONTROL_VALUE         1007
+#define _APS_NEXT_SYMED_VALUE           110
+#endif
+#endif
@@ -1,8 +1,8 @@
-#pragma once
-
-//  SDKDDKVer.h       Windows.
-
-//         Windows,  WinSDKVer.h 
-//    _WIN32_WINNT      SDKDDKVer.h.
-
-#include <SDKDDKVer.h>
+#pragma once
+
+//  SDKDDKVer.h       Windows.
+
+//         Windows,  WinSDKVer.h 
+//    _WIN32_WINNT      SDKDDKVer.h.
+
+#include <SDKDDKVer.h>
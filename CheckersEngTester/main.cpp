@@ -1,119 +1,395 @@
-// Checkers tester
-// Launches engine vs engine game for automatical testing
-// different versions of engine against each other
-// Copyright (c) 2016-2017 Yurko Prokopets (aka YurkoFlisk)
-// main.cpp, version 1.7
-
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#include <iostream>
-#include <string>
-#include <chrono>
-#include <fstream>
-#include "../Checkers/engine/board.h"
-
-// User messages
-#define CM_MOVE WM_USER
-#define CM_CPUMOVE WM_USER + 1
-#define CM_SETDEPTH WM_USER + 2
-#define CM_SETTIMELIMIT WM_USER + 3
-
-using namespace std;
-
-DWORD whitePID, blackPID, pID;
-HWND hWndFound = NULL, hWndMsgWhite = NULL, hWndMsgBlack = NULL;
-HANDLE hWhite, hBlack;
-
-// Proper resource deallocation in case of console termination
-BOOL CloseHandler(DWORD dwCtrlType)
-{
-	if (dwCtrlType == CTRL_CLOSE_EVENT)
-	{
-		TerminateProcess(hWhite, 0);
-		TerminateProcess(hBlack, 0);
-	}
-	return TRUE;
-}
-
-int main(void)
-{
-	game_state gs;
-	Move move;
-	string eng_white, eng_black;
-	SetConsoleCtrlHandler((PHANDLER_ROUTINE)CloseHandler, TRUE);
-	cout << "Enter white engine: ";
-	getline(cin, eng_white);
-	cout << "Enter black engine: ";
-	getline(cin, eng_black);
-	PROCESS_INFORMATION pi;
-	STARTUPINFO si = {};
-	si.cb = sizeof(si);
-	if (!CreateProcess(eng_white.data(), NULL, NULL, NULL, FALSE, NULL, NULL, NULL, &si, &pi))
-		return 0;
-	whitePID = pi.dwThreadId, hWhite = pi.hProcess;
-	if (!CreateProcess(eng_black.data(), NULL, NULL, NULL, FALSE, NULL, NULL, NULL, &si, &pi))
-	{
-		TerminateProcess(hWhite, 0);
-		return 0;
-	}
-	blackPID = pi.dwThreadId, hBlack = pi.hProcess;
-	WaitForInputIdle(hWhite, INFINITE);
-	WaitForInputIdle(hBlack, INFINITE);
-	while (hWndFound = FindWindowEx(HWND_MESSAGE, hWndFound, "Checkers engine interface", NULL))
-	{
-		pID = GetWindowThreadProcessId(hWndFound, NULL);
-		if (pID == whitePID)
-			hWndMsgWhite = hWndFound;
-		else if (pID == blackPID)
-			hWndMsgBlack = hWndFound;
-	}
-	if (!hWndMsgWhite || !hWndMsgBlack)
-	{
-		TerminateProcess(hWhite, 0);
-		TerminateProcess(hBlack, 0);
-		return 0;
-	}
-	int wDepth, bDepth, wTL, bTL, timer, searchedDepth;
-	cout << "Enter white depth: ";
-	cin >> wDepth;
-	cout << "Enter black depth: ";
-	cin >> bDepth;
-	cout << "Enter white time limit (ms): ";
-	cin >> wTL;
-	cout << "Enter black time limit (ms): ";
-	cin >> bTL;
-	SendMessage(hWndMsgWhite, CM_SETDEPTH, wDepth, NULL);
-	SendMessage(hWndMsgBlack, CM_SETDEPTH, bDepth, NULL);
-	SendMessage(hWndMsgWhite, CM_SETTIMELIMIT, wTL, NULL);
-	SendMessage(hWndMsgBlack, CM_SETTIMELIMIT, bTL, NULL);
-	std::ofstream log("cet_log.txt");
-	log << "DEFAULT_RULES NORMAL_GAME\n";
-	for (bool white_turn = true; ; white_turn = !white_turn)
-	{
-		auto start = chrono::high_resolution_clock::now();
-		searchedDepth = SendMessage(white_turn ? hWndMsgWhite : hWndMsgBlack, CM_CPUMOVE, NULL, NULL);
-		auto end = chrono::high_resolution_clock::now();
-		timer = chrono::duration_cast<chrono::milliseconds>(end - start).count();
-		std::ifstream in("text.txt");
-		Board::read_move(in, move);
-		in.close();
-		gs = (game_state)(SendMessage(white_turn ? hWndMsgBlack : hWndMsgWhite, CM_MOVE, NULL, NULL));
-		cout << (white_turn ? "White move: " : "Black move: ");
-		Board::write_move(cout, move);
-		cout << ' ' << timer << "ms elapsed. Searched to depth " << searchedDepth << ".\n";
-		Board::write_move(log, move);
-		log << '\n';
-		if (gs != GAME_CONTINUE)
-		{
-			cout << (gs == WHITE_WIN ? "White won this game!\n" :
-				gs == BLACK_WIN ? "Black won this game!\n" :
-				"Draw!\n");
-			SendMessage(hWndMsgWhite, WM_CLOSE, NULL, NULL);
-			SendMessage(hWndMsgBlack, WM_CLOSE, NULL, NULL);
-			break;
-		}
-	}
-	log.close();
-	system("pause");
-	return 0;
-}
\ No newline at end of file
+// Checkers tester
+// Plays engine vs engine tournaments for automatical testing
+// different versions of engine against each other (Elo estimation and SPRT)
+// Copyright (c) 2016-2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <unordered_set>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+constexpr int DEFAULT_GAMES = 1000; // Default maximum count of games
+constexpr int DEFAULT_BALLOT_PLIES = 3; // Default length of generated openings
+constexpr int DEFAULT_BASE_TIME = 10000; // Default base time per game (ms)
+constexpr int DEFAULT_INCREMENT = 100; // Default time increment per move (ms)
+constexpr int MOVES_TO_GO = 25; // Expected count of remaining moves when allocating time
+constexpr int MAX_GAME_PLY = 400; // Longer games are adjudicated as draws
+constexpr int REPORT_INTERVAL = 20; // Count of games between progress reports
+
+// Player settings given on command line as comma-separated list of key=value pairs
+struct EngineConfig
+{
+	string name;
+	int8_t depth = Checkers::UNBOUNDED_DEPTH;
+	uint64_t nodes = 0;
+	EvalParams eval_params;
+	SearchParams search_params;
+	unique_ptr<NNUE> network;
+};
+
+struct Settings
+{
+	game_rules rules = RULES_DEFAULT;
+	bool misere = false;
+	int games = DEFAULT_GAMES;
+	int threads = max<int>(thread::hardware_concurrency(), 1);
+	int base_time = DEFAULT_BASE_TIME; // Base time per game (ms), 0 if there is no game clock
+	int increment = DEFAULT_INCREMENT; // Time increment per move (ms)
+	int move_time = 0; // Fixed time per move (ms), 0 if game clock is used
+	bool sprt = false;
+	double elo0 = 0.0, elo1 = 5.0, alpha = 0.05, beta = 0.05; // SPRT hypotheses and error probabilities
+};
+
+// Tournament results from the first engine's point of view
+struct Stats
+{
+	int wins = 0, draws = 0, losses = 0, time_losses = 0;
+	inline int games(void) const noexcept
+	{
+		return wins + draws + losses;
+	}
+	inline double score(void) const noexcept
+	{
+		return (wins + draws / 2.0) / games();
+	}
+	// Per-game variance of the score
+	double variance(void) const noexcept
+	{
+		const double s = score();
+		return (wins * (1 - s) * (1 - s) + draws * (0.5 - s) * (0.5 - s) + losses * s * s) / games();
+	}
+};
+
+inline double elo_to_score(double elo)
+{
+	return 1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+inline double score_to_elo(double score)
+{
+	score = min(max(score, 1e-6), 1 - 1e-6);
+	return -400.0 * log10(1.0 / score - 1.0);
+}
+
+// Log-likelihood ratio of hypotheses elo1 and elo0 (normal approximation of trinomial distribution)
+double sprt_llr(const Stats& stats, double elo0, double elo1)
+{
+	if (stats.games() == 0 || stats.variance() == 0.0)
+		return 0.0;
+	const double s0 = elo_to_score(elo0), s1 = elo_to_score(elo1);
+	return stats.games() * (s1 - s0) * (2 * stats.score() - s0 - s1) / (2 * stats.variance());
+}
+
+void usage(void)
+{
+	cout << "Usage: CheckersEngTester -first <engine> -second <engine> [options]\n"
+		"Engine is a comma-separated list of settings: name=<name>, eval=<evaluation parameters file>,\n"
+		"search=<search parameters file>, network=<network file>, depth=<n>, nodes=<n>\n"
+		"Options:\n"
+		"  -games <n>          maximum count of games (default " << DEFAULT_GAMES << ")\n"
+		"  -threads <n>        count of concurrently played games (default is count of cores)\n"
+		"  -tc <base>+<inc>    game clock in ms (default " << DEFAULT_BASE_TIME << '+' << DEFAULT_INCREMENT << ")\n"
+		"  -movetime <ms>      fixed time per move instead of game clock\n"
+		"  -openings <file>    opening suite, one move sequence per line (default are all " << DEFAULT_BALLOT_PLIES << "-ply openings)\n"
+		"  -ballot <n>         length of generated openings\n"
+		"  -sprt <elo0> <elo1> <alpha> <beta>  stop as soon as SPRT accepts one of hypotheses\n"
+		"  -bitbase <file>     bitbase for both engines\n"
+		"  -english            play by english rules\n"
+		"  -misere             play misere games\n"
+		"Each opening is played twice with colours reversed\n";
+}
+
+void parse_engine(const string& spec, EngineConfig& config)
+{
+	stringstream ss(spec);
+	string item;
+	while (getline(ss, item, ','))
+	{
+		const size_t eq = item.find('=');
+		if (eq == string::npos)
+			throw(checkers_error("Engine setting " + item + " should have form key=value"));
+		const string key = item.substr(0, eq), value = item.substr(eq + 1);
+		if (key == "name")
+			config.name = value;
+		else if (key == "eval")
+			config.eval_params.load(value);
+		else if (key == "search")
+			config.search_params.load(value);
+		else if (key == "network")
+		{
+			config.network = make_unique<NNUE>();
+			config.network->load(value);
+		}
+		else if (key == "depth")
+			config.depth = int8_t(max(atoi(value.c_str()), 1));
+		else if (key == "nodes")
+			config.nodes = strtoull(value.c_str(), nullptr, 10);
+		else
+			throw(checkers_error("Unknown engine setting " + key));
+	}
+}
+
+// Loads opening suite (each line is a sequence of moves)
+vector<vector<Move>> load_openings(const string& file_name, const Settings& settings)
+{
+	ifstream in(file_name);
+	if (!in)
+		throw(checkers_error("Unable to open openings file " + file_name));
+	unique_ptr<Checkers> board = make_unique<Checkers>(settings.rules, settings.misere);
+	vector<vector<Move>> openings;
+	string line;
+	for (int line_idx = 1; getline(in, line); ++line_idx)
+	{
+		istringstream ss(line);
+		vector<Move> opening;
+		Move move;
+		board->restart(settings.rules, settings.misere);
+		while (Board::read_move(ss, move))
+		{
+			opening.push_back(move);
+			if (!board->move(move))
+				throw(checkers_error("Illegal move in opening at line " + to_string(line_idx)));
+		}
+		if (!opening.empty() && board->get_state() == GAME_CONTINUE)
+			openings.push_back(opening);
+	}
+	return openings;
+}
+
+// Generates all openings of given length (positions reached by different move orders are taken once)
+void generate_openings(Checkers& board, int plies, vector<Move>& prefix,
+	unordered_set<uint64_t>& seen, vector<vector<Move>>& openings)
+{
+	if (board.get_state() != GAME_CONTINUE)
+		return;
+	if (plies == 0)
+	{
+		if (seen.insert(board.get_full_hash()).second)
+			openings.push_back(prefix);
+		return;
+	}
+	const vector<Move> moves = board.get_part_possible_moves();
+	for (Move move : moves)
+	{
+		prefix.push_back(move);
+		board.move(move);
+		generate_openings(board, plies - 1, prefix, seen, openings);
+		board.undo_move();
+		prefix.pop_back();
+	}
+}
+
+// Plays a game from given opening where the first engine plays given colour. Returns its result from the
+// first engine's point of view (1 - win, 0 - draw, -1 - loss). Loss on time is reported through the last parameter
+int play_game(Checkers* (&engines)[2], const vector<Move>& opening, colour first_colour, const Settings& settings, bool& time_loss)
+{
+	for (Checkers* engine : engines)
+	{
+		engine->restart(settings.rules, settings.misere);
+		for (Move move : opening)
+			engine->move(move);
+	}
+	double clock[2] = { double(settings.base_time), double(settings.base_time) };
+	game_state state = GAME_CONTINUE;
+	time_loss = false;
+	while (state == GAME_CONTINUE && engines[0]->get_current_ply() < MAX_GAME_PLY)
+	{
+		const int side = (engines[0]->current_turn_colour() == first_colour ? 0 : 1);
+		Checkers& engine = *engines[side];
+		if (settings.move_time > 0)
+			engine.set_time_limit(float(settings.move_time));
+		else if (settings.base_time > 0)
+			engine.set_time_limit(float(min(clock[side] / MOVES_TO_GO + settings.increment * 0.75, clock[side] / 2)));
+		Move move;
+		const auto start = chrono::steady_clock::now();
+		const int8_t depth = engine.get_computer_move(move);
+		const double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		if (depth == 0)
+		{
+			state = engine.get_state(); // No moves (or no iteration was finished at all)
+			if (state != GAME_CONTINUE)
+				break;
+			time_loss = true; // Engine failed to give a move in its time, so it loses like on flag fall
+			return side == 0 ? -1 : 1;
+		}
+		if (settings.move_time == 0 && settings.base_time > 0)
+		{
+			clock[side] -= elapsed;
+			if (clock[side] < 0)
+			{
+				time_loss = true;
+				return side == 0 ? -1 : 1;
+			}
+			clock[side] += settings.increment;
+		}
+		for (Checkers* cur : engines)
+		{
+			Move copy = move;
+			cur->move(copy);
+		}
+		state = engines[0]->get_state();
+	}
+	if (state == WHITE_WIN || state == BLACK_WIN)
+		return (state == WHITE_WIN) == (first_colour == WHITE) ? 1 : -1;
+	return 0;
+}
+
+void report(const Stats& stats, const EngineConfig (&configs)[2], const Settings& settings)
+{
+	const double s = stats.score(), error = 1.96 * sqrt(stats.variance() / stats.games());
+	cout << configs[0].name << " vs " << configs[1].name << ": " << stats.games() << " games, +"
+		<< stats.wins << " =" << stats.draws << " -" << stats.losses << " (" << stats.time_losses << " on time), score "
+		<< fixed << setprecision(1) << s * 100 << "%, Elo " << score_to_elo(s) << " +- "
+		<< (score_to_elo(s + error) - score_to_elo(s - error)) / 2;
+	if (settings.sprt)
+		cout << setprecision(2) << ", LLR " << sprt_llr(stats, settings.elo0, settings.elo1) << " ["
+			<< log(settings.beta / (1 - settings.alpha)) << "; " << log((1 - settings.beta) / settings.alpha) << ']';
+	cout << defaultfloat << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	Settings settings;
+	EngineConfig configs[2];
+	configs[0].name = "first", configs[1].name = "second";
+	string openings_file, bitbase_file;
+	int ballot_plies = DEFAULT_BALLOT_PLIES;
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const bool has_value = (i + 1 < argc);
+			if (strcmp(argv[i], "-first") == 0 && has_value)
+				parse_engine(argv[++i], configs[0]);
+			else if (strcmp(argv[i], "-second") == 0 && has_value)
+				parse_engine(argv[++i], configs[1]);
+			else if (strcmp(argv[i], "-games") == 0 && has_value)
+				settings.games = max(atoi(argv[++i]), 1);
+			else if (strcmp(argv[i], "-threads") == 0 && has_value)
+				settings.threads = max(atoi(argv[++i]), 1);
+			else if (strcmp(argv[i], "-tc") == 0 && has_value)
+			{
+				const char* tc = argv[++i];
+				settings.base_time = atoi(tc);
+				settings.increment = (strchr(tc, '+') != nullptr ? atoi(strchr(tc, '+') + 1) : 0);
+			}
+			else if (strcmp(argv[i], "-movetime") == 0 && has_value)
+				settings.move_time = max(atoi(argv[++i]), 1);
+			else if (strcmp(argv[i], "-openings") == 0 && has_value)
+				openings_file = argv[++i];
+			else if (strcmp(argv[i], "-ballot") == 0 && has_value)
+				ballot_plies = max(atoi(argv[++i]), 0);
+			else if (strcmp(argv[i], "-sprt") == 0 && i + 4 < argc)
+			{
+				settings.sprt = true;
+				settings.elo0 = atof(argv[++i]), settings.elo1 = atof(argv[++i]);
+				settings.alpha = atof(argv[++i]), settings.beta = atof(argv[++i]);
+			}
+			else if (strcmp(argv[i], "-bitbase") == 0 && has_value)
+				bitbase_file = argv[++i];
+			else if (strcmp(argv[i], "-english") == 0)
+				settings.rules = RULES_ENGLISH;
+			else if (strcmp(argv[i], "-misere") == 0)
+				settings.misere = true;
+			else
+			{
+				usage();
+				return 1;
+			}
+		}
+		Bitbase bitbase;
+		if (!bitbase_file.empty())
+			bitbase.load(bitbase_file);
+		// Opening suite
+		vector<vector<Move>> openings;
+		if (!openings_file.empty())
+			openings = load_openings(openings_file, settings);
+		else
+		{
+			unique_ptr<Checkers> board = make_unique<Checkers>(settings.rules, settings.misere);
+			vector<Move> prefix;
+			unordered_set<uint64_t> seen;
+			generate_openings(*board, ballot_plies, prefix, seen, openings);
+		}
+		if (openings.empty())
+			throw(checkers_error("Opening suite is empty"));
+		shuffle(openings.begin(), openings.end(), mt19937(random_device()()));
+		cout << openings.size() << " openings" << endl;
+		// Engines (each thread has an instance of both)
+		const int pairs = (settings.games + 1) / 2;
+		settings.threads = min(settings.threads, pairs);
+		vector<unique_ptr<Checkers>> engines;
+		for (int t = 0; t < settings.threads; ++t)
+			for (const auto& config : configs)
+			{
+				engines.push_back(make_unique<Checkers>(settings.rules, settings.misere));
+				Checkers& engine = *engines.back();
+				engine.set_search_depth(config.depth);
+				engine.set_node_limit(config.nodes);
+				engine.set_eval_params(config.eval_params);
+				engine.set_search_params(config.search_params);
+				engine.set_network(config.network.get());
+				engine.set_bitbase(&bitbase);
+				if (settings.move_time == 0 && settings.base_time == 0)
+					engine.set_time_limit(1e9f); // Only depth or node budget limits the search
+			}
+		// Play the tournament
+		Stats stats;
+		mutex stats_mutex;
+		atomic<int> next_pair(0);
+		atomic<bool> stop(false);
+		const double llr_lower = log(settings.beta / (1 - settings.alpha)), llr_upper = log((1 - settings.beta) / settings.alpha);
+		vector<thread> workers;
+		for (int t = 0; t < settings.threads; ++t)
+			workers.emplace_back([&, t]() {
+				Checkers* thread_engines[2] = { engines[2 * t].get(), engines[2 * t + 1].get() };
+				for (int pair; !stop && (pair = next_pair++) < pairs; )
+					for (colour first_colour : { WHITE, BLACK })
+					{
+						bool time_loss;
+						const int result = play_game(thread_engines, openings[pair % openings.size()],
+							first_colour, settings, time_loss);
+						lock_guard<mutex> lock(stats_mutex);
+						(result > 0 ? stats.wins : result < 0 ? stats.losses : stats.draws)++;
+						stats.time_losses += time_loss;
+						if (stats.games() % REPORT_INTERVAL == 0)
+							report(stats, configs, settings);
+						if (settings.sprt && !stop)
+						{
+							const double llr = sprt_llr(stats, settings.elo0, settings.elo1);
+							if (llr <= llr_lower || llr >= llr_upper)
+							{
+								stop = true;
+								cout << "SPRT: H" << (llr >= llr_upper ? 1 : 0) << " (Elo " << (llr >= llr_upper ?
+									settings.elo1 : settings.elo0) << ") is accepted" << endl;
+							}
+						}
+					}
+			});
+		for (auto& worker : workers)
+			worker.join();
+		if (stats.games() % REPORT_INTERVAL != 0)
+			report(stats, configs, settings);
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,383 @@
+// Checkers engine interface
+// Line-based text protocol over standard input and output for accessing the engine
+// (used by CheckersEngTester and other programs that run engine processes)
+// Copyright (c) 2016-2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/async_search.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+constexpr const char* ENGINE_NAME = "Checkers 1.8";
+constexpr const char* ENGINE_AUTHOR = "Yurko Prokopets";
+constexpr int MOVES_TO_GO = 25; // Expected count of remaining moves when allocating time from game clock
+constexpr int PV_MAX_LENGTH = 32; // Maximum length of reported principal variation
+constexpr int MAX_HASH_SIZE = 65536; // Maximum size of transposition tables, MB
+constexpr float UNLIMITED_TIME = 1e9f; // Time limit of searches which are limited otherwise (or stopped by command)
+
+class Interface
+{
+public:
+	Interface(void);
+	void run(void); // Executes commands from standard input until quit command or end of input
+private:
+	void send(const string&); // Outputs a line (from any thread)
+	static string move_str(const Move&);
+	void on_info(const SearchInfo&);
+	void on_result(const SearchResult&);
+	void send_bestmove(const SearchResult&);
+	// Commands
+	void cmd_checkers(void);
+	void cmd_setoption(istream&);
+	void cmd_newgame(void);
+	void cmd_position(istream&);
+	void cmd_go(istream&);
+	void cmd_stop(void);
+	void cmd_ponderhit(void);
+	// Members
+	unique_ptr<Checkers> engine;
+	AsyncSearch search;
+	mutex output_mutex;
+	mutex result_mutex;
+	bool hold_result; // Whether result should be held until stop or ponderhit (in ponder and infinite modes)
+	bool has_result; // Whether held result is present
+	SearchResult held_result;
+	float ponder_time; // Time allocated for the search after ponderhit
+	game_rules rules;
+	bool misere;
+	string game_start; // Start of the game which is set on the engine (position command before its moves, empty after newgame)
+	vector<string> game_moves; // Moves of the game which is set on the engine
+	int8_t depth; // Depth option
+	uint64_t nodes; // Node budget option
+	float move_time; // Default time per move option (when go doesn't give it)
+	vector<unique_ptr<Bitbase>> bitbases; // Loaded resources (they should outlive their use by engine)
+	vector<unique_ptr<OpeningBook>> books;
+	vector<unique_ptr<NNUE>> networks;
+};
+
+Interface::Interface(void)
+	: engine(make_unique<Checkers>()), search(*engine), hold_result(false), has_result(false), ponder_time(0),
+	rules(RULES_DEFAULT), misere(false), depth(Checkers::UNBOUNDED_DEPTH), nodes(0), move_time(Checkers::DEFAULT_TIME_LIMIT)
+{
+	engine->set_info_callback([this](const SearchInfo& info) { on_info(info); });
+}
+
+void Interface::send(const string& line)
+{
+	lock_guard<mutex> lock(output_mutex);
+	cout << line << endl;
+}
+
+string Interface::move_str(const Move& move)
+{
+	ostringstream ss;
+	Board::write_move(ss, move);
+	return ss.str();
+}
+
+// Called from the search thread after each finished iteration
+void Interface::on_info(const SearchInfo& info)
+{
+	vector<Move> pv;
+	engine->get_pv(pv, PV_MAX_LENGTH);
+	ostringstream ss;
+	ss << "info depth " << int(info.depth) << " score " << info.score << " nodes " << info.nodes
+		<< " time " << int64_t(info.time) << " nps " << uint64_t(info.nodes * 1000.0 / max(info.time, 1.0f)) << " pv";
+	for (const Move& move : pv)
+		ss << ' ' << move_str(move);
+	send(ss.str());
+}
+
+// Called from the search thread when it finishes
+void Interface::on_result(const SearchResult& result)
+{
+	lock_guard<mutex> lock(result_mutex);
+	if (hold_result)
+		held_result = result, has_result = true;
+	else
+		send_bestmove(result);
+}
+
+void Interface::send_bestmove(const SearchResult& result)
+{
+	if (result.move.size() == 0)
+	{
+		send("bestmove none");
+		return;
+	}
+	string line = "bestmove " + move_str(result.move);
+	// Expected reply is taken from the principal variation (board is at the root after search)
+	vector<Move> pv;
+	engine->get_pv(pv, 2);
+	if (pv.size() == 2 && pv[0] == result.move)
+		line += " ponder " + move_str(pv[1]);
+	send(line);
+}
+
+void Interface::cmd_checkers(void)
+{
+	send(string("id name ") + ENGINE_NAME);
+	send(string("id author ") + ENGINE_AUTHOR);
+	send("option name hash type spin default " + to_string(engine->get_hash_size()) + " min 1 max " + to_string(MAX_HASH_SIZE));
+	send("option name threads type spin default 1 min 1 max 1");
+	send("option name depth type spin default 0 min 0 max " + to_string(Checkers::MAX_SEARCH_DEPTH));
+	send("option name nodes type spin default 0 min 0 max 1000000000000");
+	send("option name movetime type spin default " + to_string(int(Checkers::DEFAULT_TIME_LIMIT)) + " min 1 max 1000000000");
+	for (const char* file_option : { "evalfile", "searchfile", "networkfile", "bitbasefile", "bookfile" })
+		send(string("option name ") + file_option + " type string default <empty>");
+	for (const auto& info : SEARCH_PARAM_INFO)
+		send(string("option name ") + info.name + " type spin default " + to_string(info.default_value)
+			+ " min " + to_string(info.min_value) + " max " + to_string(info.max_value));
+	send("checkersok");
+}
+
+void Interface::cmd_setoption(istream& istr)
+{
+	string token, name, value;
+	istr >> token >> name; // "name <name>"
+	if (token != "name" || name.empty())
+		throw(checkers_error("setoption should be followed by name <name> value <value>"));
+	istr >> token;
+	getline(istr >> ws, value);
+	search.wait();
+	if (name == "hash")
+		engine->set_hash_size(min(max(atoi(value.c_str()), 1), MAX_HASH_SIZE));
+	else if (name == "threads")
+	{
+		if (atoi(value.c_str()) != 1)
+			send("info string only single-threaded search is supported");
+	}
+	else if (name == "depth")
+		depth = (atoi(value.c_str()) <= 0 ? Checkers::UNBOUNDED_DEPTH :
+			int8_t(min<int>(atoi(value.c_str()), Checkers::MAX_SEARCH_DEPTH)));
+	else if (name == "nodes")
+		nodes = strtoull(value.c_str(), nullptr, 10);
+	else if (name == "movetime")
+		move_time = float(max(atoi(value.c_str()), 1));
+	else if (name == "evalfile")
+	{
+		EvalParams params;
+		params.load(value);
+		engine->set_eval_params(params);
+	}
+	else if (name == "searchfile")
+	{
+		SearchParams params;
+		params.load(value);
+		engine->set_search_params(params);
+	}
+	else if (name == "networkfile")
+	{
+		networks.push_back(make_unique<NNUE>());
+		networks.back()->load(value);
+		engine->set_network(networks.back().get());
+	}
+	else if (name == "bitbasefile")
+	{
+		bitbases.push_back(make_unique<Bitbase>());
+		bitbases.back()->load(value);
+		engine->set_bitbase(bitbases.back().get());
+	}
+	else if (name == "bookfile")
+	{
+		books.push_back(make_unique<OpeningBook>());
+		books.back()->open(value);
+		engine->set_book(books.back().get());
+	}
+	else if (SearchParams::find(name) != SEARCH_PARAM_COUNT)
+	{
+		SearchParams params = engine->get_search_params();
+		params.set(SearchParams::find(name), atoi(value.c_str()));
+		engine->set_search_params(params);
+	}
+	else
+		throw(checkers_error("Unknown option " + name));
+}
+
+void Interface::cmd_newgame(void)
+{
+	search.wait();
+	engine->restart(rules, misere);
+	game_start.clear();
+	game_moves.clear();
+}
+
+// position [english] [misere] (startpos | fen <position string>) [moves <move>...]
+void Interface::cmd_position(istream& istr)
+{
+	game_rules new_rules = RULES_DEFAULT;
+	bool new_misere = false;
+	string token, fen;
+	vector<string> moves;
+	while (istr >> token && token != "startpos" && token != "fen")
+		if (token == "english")
+			new_rules = RULES_ENGLISH;
+		else if (token == "misere")
+			new_misere = true;
+		else
+			throw(checkers_error("Unknown position token " + token));
+	if (token == "fen" && !(istr >> fen))
+		throw(checkers_error("position fen should be followed by position string"));
+	else if (token != "startpos" && token != "fen")
+		throw(checkers_error("position should contain startpos or fen"));
+	if (istr >> token && token == "moves")
+		while (istr >> token)
+			moves.push_back(token);
+	const string new_start = string(new_rules == RULES_ENGLISH ? "english " : "") + (new_misere ? "misere " : "")
+		+ (fen.empty() ? "startpos" : "fen " + fen);
+	search.wait();
+	// Continue current game if the new one extends it (so that transposition tables stay useful)
+	size_t first_new = 0;
+	if (new_start == game_start && moves.size() >= game_moves.size()
+		&& equal(game_moves.begin(), game_moves.end(), moves.begin()))
+		first_new = game_moves.size();
+	else
+	{
+		game_start.clear();
+		game_moves.clear();
+		engine->restart(new_rules, new_misere);
+		// Rules of position string (if it has them) take precedence over rules tokens
+		if (!fen.empty() && !engine->set_fen(fen.data(), fen.data() + fen.size()))
+			throw(checkers_error("Position string is malformed"));
+		rules = engine->get_rules(), misere = engine->get_misere();
+		game_start = new_start;
+	}
+	for (size_t i = first_new; i < moves.size(); ++i)
+	{
+		istringstream ss(moves[i]);
+		Move move;
+		Board::read_move(ss, move);
+		if (!engine->move(move))
+			throw(checkers_error("Illegal move " + moves[i]));
+		game_moves.push_back(moves[i]);
+	}
+}
+
+// go [depth <n>] [nodes <n>] [movetime <ms>] [wtime <ms>] [btime <ms>] [winc <ms>] [binc <ms>] [infinite] [ponder]
+void Interface::cmd_go(istream& istr)
+{
+	int8_t go_depth = depth;
+	uint64_t go_nodes = nodes;
+	float go_move_time = 0, time[2] = { -1, -1 }, increment[2] = { 0, 0 };
+	bool infinite = false, ponder = false, limited = false; // limited - whether depth or nodes are given explicitly
+	string token;
+	while (istr >> token)
+		if (token == "depth")
+			limited = true, istr >> token, go_depth = int8_t(min(max(atoi(token.c_str()), 1), int(Checkers::MAX_SEARCH_DEPTH)));
+		else if (token == "nodes")
+			limited = true, istr >> go_nodes;
+		else if (token == "movetime")
+			istr >> go_move_time;
+		else if (token == "wtime" || token == "btime")
+			istr >> time[token[0] == 'w' ? 0 : 1];
+		else if (token == "winc" || token == "binc")
+			istr >> increment[token[0] == 'w' ? 0 : 1];
+		else if (token == "infinite")
+			infinite = true;
+		else if (token == "ponder")
+			ponder = true;
+		else
+			throw(checkers_error("Unknown go token " + token));
+	search.wait();
+	// Time allocation
+	const int side = (engine->current_turn_colour() == WHITE ? 0 : 1);
+	float time_limit = move_time;
+	if (go_move_time > 0)
+		time_limit = go_move_time;
+	else if (time[side] >= 0)
+		time_limit = max(min(time[side] / MOVES_TO_GO + increment[side] * 0.75f, time[side] / 2), 1.0f);
+	else if (limited || infinite)
+		time_limit = UNLIMITED_TIME; // Search is limited by given depth or nodes or by stop command
+	engine->set_search_depth(go_depth);
+	engine->set_node_limit(go_nodes);
+	engine->set_time_limit(ponder ? UNLIMITED_TIME : time_limit);
+	{
+		lock_guard<mutex> lock(result_mutex);
+		hold_result = (infinite || ponder);
+		has_result = false;
+		ponder_time = time_limit;
+	}
+	search.start([this](const SearchResult& result) { on_result(result); });
+}
+
+void Interface::cmd_stop(void)
+{
+	{
+		lock_guard<mutex> lock(result_mutex);
+		hold_result = false;
+		if (has_result)
+		{
+			has_result = false;
+			send_bestmove(held_result);
+		}
+	}
+	search.stop();
+}
+
+// Opponent played expected move, so pondering search becomes a normal one
+void Interface::cmd_ponderhit(void)
+{
+	lock_guard<mutex> lock(result_mutex);
+	hold_result = false;
+	if (has_result)
+	{
+		has_result = false;
+		send_bestmove(held_result);
+	}
+	else if (search.is_running())
+		search.stop_after(ponder_time);
+}
+
+void Interface::run(void)
+{
+	string line, command;
+	while (getline(cin, line))
+	{
+		istringstream ss(line);
+		if (!(ss >> command))
+			continue;
+		try
+		{
+			if (command == "checkers")
+				cmd_checkers();
+			else if (command == "isready")
+				send("readyok");
+			else if (command == "setoption")
+				cmd_setoption(ss);
+			else if (command == "newgame")
+				cmd_newgame();
+			else if (command == "position")
+				cmd_position(ss);
+			else if (command == "go")
+				cmd_go(ss);
+			else if (command == "stop")
+				cmd_stop();
+			else if (command == "ponderhit")
+				cmd_ponderhit();
+			else if (command == "quit")
+				break;
+			else
+				send("info string unknown command " + command);
+		}
+		catch (const checkers_error& err)
+		{
+			send(string("info string ") + err.what());
+		}
+	}
+	cmd_stop();
+	search.wait();
+}
+
+int main(void)
+{
+	ios::sync_with_stdio(false);
+	Interface().run();
+	return 0;
+}
@@ -0,0 +1,241 @@
+// Checkers batch analyzer
+// Searches positions from a file by a pool of engines and outputs their scores, best moves and variations
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/task_pool.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <map>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+constexpr int DEFAULT_DEPTH = 10; // Default search depth (when neither depth nor node budget is given)
+constexpr int DEFAULT_PV_LENGTH = 10;
+constexpr size_t DEFAULT_HASH_PER_WORKER = 16; // MB
+constexpr size_t TASKS_PER_WORKER = 64; // Maximum count of positions which are read ahead of the output per worker
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_Analyzer <input file> <output file> [options]\n"
+		"Input consists of positions in save_board format (either on separate lines or on one line each),\n"
+		"every position begins with rules token, or position strings (FEN with optional game type, e.g.\n"
+		"25:W:W21-32:B1-12), one per line. Empty lines and lines beginning with # are skipped.\n"
+		"Output has a line per position in the same order:\n"
+		"  <number> score <score> depth <depth> nodes <nodes> bestmove <move> pv <moves>\n"
+		"  <number> result <white|black|draw> (if the game is finished)\n"
+		"  <number> error <message>\n"
+		"Options:\n"
+		"  -depth <n>       search depth (default " << DEFAULT_DEPTH << " if node budget isn't given)\n"
+		"  -nodes <n>       node budget per position\n"
+		"  -threads <n>     count of threads (default is count of cores)\n"
+		"  -hash <MB>       overall size of transposition tables, split between threads (default "
+		<< DEFAULT_HASH_PER_WORKER << " per thread)\n"
+		"  -pv <n>          maximum length of principal variation (default " << DEFAULT_PV_LENGTH << ")\n"
+		"  -bitbase <file>  use given bitbase\n"
+		"  -network <file>  use given network for evaluation\n";
+}
+
+// Writes results in order of positions while they arrive from workers in any order
+class OrderedOutput
+{
+public:
+	OrderedOutput(ostream& out)
+		: out(out), next(1)
+	{}
+	void put(uint64_t number, string line)
+	{
+		{
+			lock_guard<mutex> lock(result_mutex);
+			results.emplace(number, move(line));
+			for (auto it = results.begin(); it != results.end() && it->first == next; it = results.erase(it), ++next)
+				out << it->first << ' ' << it->second << '\n';
+		}
+		written_cv.notify_all();
+	}
+	// Waits until at most given count of positions before the given one are not written yet
+	void wait_behind(uint64_t number, uint64_t count)
+	{
+		unique_lock<mutex> lock(result_mutex);
+		written_cv.wait(lock, [&] { return next + count > number; });
+	}
+private:
+	ostream& out;
+	uint64_t next; // Number of the next position to write
+	map<uint64_t, string> results; // Results which wait for previous ones
+	mutex result_mutex;
+	condition_variable written_cv;
+};
+
+string move_str(const Move& move)
+{
+	ostringstream ss;
+	Board::write_move(ss, move);
+	return ss.str();
+}
+
+// Searches given position by given engine and returns result line (without number)
+string analyze(Checkers& engine, const string& position, int pv_length)
+{
+	try
+	{
+		// Search state left by previous positions (transposition tables, killers and history) is cleared,
+		// so that results don't depend on count of threads and order of tasks
+		engine.restart();
+		istringstream in(position);
+		engine.load_board(in);
+		// Game may be already finished in given position
+		const game_state state = engine.get_state();
+		if (state != GAME_CONTINUE)
+			return string("result ") + (state == WHITE_WIN ? "white" : state == BLACK_WIN ? "black" : "draw");
+		Move best;
+		int score = 0;
+		const int depth = engine.get_computer_move(best, score);
+		ostringstream ss;
+		ss << "score " << score << " depth " << depth << " nodes " << engine.get_nodes() << " bestmove ";
+		if (depth == 0)
+			ss << "none pv";
+		else
+		{
+			vector<Move> pv;
+			engine.get_pv(pv, pv_length);
+			if (pv.empty() || pv[0] != best)
+				pv.assign(1, best);
+			ss << move_str(best) << " pv";
+			for (const Move& move : pv)
+				ss << ' ' << move_str(move);
+		}
+		return ss.str();
+	}
+	catch (const checkers_error& err)
+	{
+		return string("error ") + err.what();
+	}
+}
+
+// Returns whether given line begins a position (with rules token or position string, which has a colon)
+bool is_position_start(const string& line)
+{
+	istringstream ss(line);
+	string token;
+	ss >> token;
+	return token == "DEFAULT_RULES" || token == "ENGLISH_RULES" || token.find(':') != string::npos;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		usage();
+		return 1;
+	}
+	int threads = max<int>(thread::hardware_concurrency(), 1), depth = 0, pv_length = DEFAULT_PV_LENGTH;
+	uint64_t node_limit = 0;
+	size_t hash = 0;
+	string bitbase_file, network_file;
+	for (int i = 3; i < argc; ++i)
+	{
+		const bool has_value = (i + 1 < argc);
+		if (strcmp(argv[i], "-depth") == 0 && has_value)
+			depth = min(max(atoi(argv[++i]), 1), int(Checkers::MAX_SEARCH_DEPTH));
+		else if (strcmp(argv[i], "-nodes") == 0 && has_value)
+			node_limit = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-threads") == 0 && has_value)
+			threads = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-hash") == 0 && has_value)
+			hash = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-pv") == 0 && has_value)
+			pv_length = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-bitbase") == 0 && has_value)
+			bitbase_file = argv[++i];
+		else if (strcmp(argv[i], "-network") == 0 && has_value)
+			network_file = argv[++i];
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	if (depth == 0 && node_limit == 0)
+		depth = DEFAULT_DEPTH;
+	if (hash == 0)
+		hash = DEFAULT_HASH_PER_WORKER * threads;
+	try
+	{
+		ifstream in(argv[1]);
+		if (!in)
+			throw(checkers_error(string("Unable to open input file ") + argv[1]));
+		ofstream out(argv[2]);
+		if (!out)
+			throw(checkers_error(string("Unable to create output file ") + argv[2]));
+		Bitbase bitbase;
+		NNUE network;
+		if (!bitbase_file.empty())
+			bitbase.load(bitbase_file);
+		if (!network_file.empty())
+			network.load(network_file);
+		// Every worker has its own engine with its slice of transposition tables, so they share nothing
+		// (and every position is searched from cleared tables, see analyze)
+		vector<unique_ptr<Checkers>> engines;
+		for (int i = 0; i < threads; ++i)
+		{
+			engines.push_back(make_unique<Checkers>());
+			engines.back()->set_hash_size(max<size_t>(hash / threads, 1));
+			engines.back()->set_search_depth(depth != 0 ? int8_t(depth) : Checkers::UNBOUNDED_DEPTH);
+			engines.back()->set_time_limit(1e9f); // Only depth or node budget limits the search
+			engines.back()->set_node_limit(node_limit);
+			engines.back()->set_bitbase(&bitbase);
+			engines.back()->set_network(&network);
+		}
+		OrderedOutput output(out);
+		uint64_t count = 0;
+		const auto start_time = chrono::steady_clock::now();
+		auto last_report = start_time;
+		{
+			TaskPool pool(threads);
+			const auto submit = [&](string position) {
+				++count;
+				// Reading doesn't go too far ahead of the output, so memory doesn't depend on input size
+				output.wait_behind(count, TASKS_PER_WORKER * threads);
+				pool.submit([&engines, &output, pv_length, number = count, position = move(position)](int worker) {
+					output.put(number, analyze(*engines[worker], position, pv_length));
+				});
+				const auto now = chrono::steady_clock::now();
+				if (now - last_report >= chrono::seconds(10))
+				{
+					last_report = now;
+					const double seconds = chrono::duration<double>(now - start_time).count();
+					cout << "Positions: " << count << " (" << uint64_t(count / seconds) << " per second)" << endl;
+				}
+			};
+			string line, position;
+			while (getline(in, line))
+			{
+				if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == string::npos)
+					continue;
+				if (is_position_start(line) && !position.empty())
+					submit(move(position)), position.clear();
+				position += line;
+				position += '\n';
+			}
+			if (!position.empty())
+				submit(move(position));
+		} // Pool's destructor waits for the remaining positions
+		const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+		cout << "Done. " << count << " positions are analyzed in " << seconds << " s ("
+			<< uint64_t(count / max(seconds, 1e-3)) << " per second), results are written to " << argv[2] << '\n';
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
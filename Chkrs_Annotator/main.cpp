@@ -0,0 +1,277 @@
+// Checkers game annotator
+// Searches every position of finished games in parallel and reports evaluations of moves, best alternatives and mistakes
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/task_pool.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <dirent.h>
+#endif
+
+using namespace std;
+
+constexpr int DEFAULT_DEPTH = 10; // Default search depth (when neither depth nor node budget is given)
+constexpr size_t DEFAULT_HASH_PER_WORKER = 16; // MB
+constexpr int DEFAULT_MISTAKE = 50; // Default score loss of a mistake
+constexpr int DEFAULT_BLUNDER = 150; // Default score loss of a blunder
+constexpr int DECISIVE_SCORE = 1000; // Scores are clamped by this when computing loss (so that slower wins aren't mistakes)
+
+struct Settings
+{
+	int mistake = DEFAULT_MISTAKE;
+	int blunder = DEFAULT_BLUNDER;
+};
+
+atomic<uint64_t> positions(0);
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_Annotator <output file> <game file or directory>... [options]\n"
+		"Games are in save_game format. Report has a block per game in the order of inputs (files of\n"
+		"a directory are sorted by name) with a line per move:\n"
+		"  <ply> <W|B> <move> <score> [best <move> <score>] [?|??]\n"
+		"where scores are from the point of view of the moving side, ? marks a mistake and ?? a blunder.\n"
+		"Options:\n"
+		"  -depth <n>       search depth (default " << DEFAULT_DEPTH << " if node budget isn't given)\n"
+		"  -nodes <n>       node budget per position\n"
+		"  -threads <n>     count of threads (default is count of cores)\n"
+		"  -hash <MB>       overall size of transposition tables, split between threads (default "
+		<< DEFAULT_HASH_PER_WORKER << " per thread)\n"
+		"  -mistake <n>     score loss of a mistake (default " << DEFAULT_MISTAKE << ")\n"
+		"  -blunder <n>     score loss of a blunder (default " << DEFAULT_BLUNDER << ")\n"
+		"  -bitbase <file>  use given bitbase\n"
+		"  -network <file>  use given network for evaluation\n";
+}
+
+// Appends files of given directory (sorted by name) to the list. Returns false if it isn't a directory
+bool list_directory(const string& dir, vector<string>& files)
+{
+	vector<string> names;
+#ifdef _WIN32
+	WIN32_FIND_DATAA data;
+	const HANDLE handle = FindFirstFileA((dir + "\\*").c_str(), &data);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	do
+		if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+			names.push_back(data.cFileName);
+	while (FindNextFileA(handle, &data));
+	FindClose(handle);
+	const char separator = '\\';
+#else
+	DIR* handle = opendir(dir.c_str());
+	if (handle == nullptr)
+		return false;
+	while (const dirent* entry = readdir(handle))
+		if (entry->d_name[0] != '.')
+			names.push_back(entry->d_name);
+	closedir(handle);
+	const char separator = '/';
+#endif
+	sort(names.begin(), names.end());
+	for (const string& name : names)
+		files.push_back(dir + separator + name);
+	return true;
+}
+
+string move_str(const Move& move)
+{
+	ostringstream ss;
+	Board::write_move(ss, move);
+	return ss.str();
+}
+
+// Returns the score of finished game's position for the side to move
+int final_score(const Checkers& engine)
+{
+	const game_state state = engine.get_state();
+	if (state == DRAW)
+		return 0;
+	return (state == WHITE_WIN) == (engine.current_turn_colour() == WHITE) ? Checkers::MAX_SCORE : -Checkers::MAX_SCORE;
+}
+
+// Annotates game from given file by given engine. Positions are searched from the last one to the first,
+// so that transposition table entries of later positions (which are shared by the game) help earlier ones
+string annotate(Checkers& engine, const string& file, const Settings& settings)
+{
+	ostringstream report;
+	report << "game " << file;
+	try
+	{
+		ifstream in(file);
+		if (!in)
+			throw(checkers_error("Unable to open the file"));
+		try
+		{
+			engine.load_game(in);
+		}
+		catch (const checkers_error& err)
+		{
+			if (err.get_error_type() != error_type::WARNING)
+				throw;
+		}
+		const game_state state = engine.get_state();
+		const int ply_count = engine.get_current_ply();
+		report << (engine.get_rules() == RULES_DEFAULT ? " DEFAULT_RULES " : " ENGLISH_RULES ")
+			<< (engine.get_misere() ? "MISERE_GAME" : "NORMAL_GAME") << " plies " << ply_count << " result "
+			<< (state == WHITE_WIN ? "white" : state == BLACK_WIN ? "black" : state == DRAW ? "draw" : "unfinished") << '\n';
+		vector<string> lines(ply_count);
+		Move best;
+		int next_score = 0; // Score of the position after the played move for the side to move there
+		if (state != GAME_CONTINUE)
+			next_score = final_score(engine);
+		else if (engine.get_computer_move(best, next_score) != 0)
+			++positions;
+		int mistakes[2] = {}, blunders[2] = {};
+		for (int ply = ply_count - 1; ply >= 0; --ply)
+		{
+			const Move played = engine.get_last_move();
+			engine.undo_move();
+			const colour turn = engine.current_turn_colour();
+			int best_score = -next_score;
+			if (engine.get_computer_move(best, best_score) != 0)
+				++positions;
+			else
+				best = played;
+			// Search examines one of equivalent capture paths, so moves are compared by resulting positions
+			const bool best_played = (best == played || engine.child_hash(best) == engine.child_hash(played));
+			const int played_score = (best_played ? best_score : -next_score);
+			const int loss = max(min(best_score, DECISIVE_SCORE), -DECISIVE_SCORE)
+				- max(min(played_score, DECISIVE_SCORE), -DECISIVE_SCORE);
+			ostringstream line;
+			line << ply + 1 << (turn == WHITE ? " W " : " B ") << move_str(played) << ' ' << played_score;
+			if (!best_played)
+				line << " best " << move_str(best) << ' ' << best_score;
+			if (loss >= settings.blunder)
+				line << " ??", ++blunders[turn == WHITE ? 0 : 1];
+			else if (loss >= settings.mistake)
+				line << " ?", ++mistakes[turn == WHITE ? 0 : 1];
+			lines[ply] = line.str();
+			next_score = best_score;
+		}
+		for (const string& line : lines)
+			report << line << '\n';
+		report << "summary white " << mistakes[0] << " mistakes " << blunders[0] << " blunders, black "
+			<< mistakes[1] << " mistakes " << blunders[1] << " blunders\n";
+	}
+	catch (const checkers_error& err)
+	{
+		report << " error " << err.what() << '\n';
+	}
+	return report.str();
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		usage();
+		return 1;
+	}
+	Settings settings;
+	int threads = max<int>(thread::hardware_concurrency(), 1), depth = 0;
+	uint64_t node_limit = 0;
+	size_t hash = 0;
+	string bitbase_file, network_file;
+	vector<string> files;
+	for (int i = 2; i < argc; ++i)
+	{
+		const bool has_value = (i + 1 < argc);
+		if (argv[i][0] != '-')
+		{
+			if (!list_directory(argv[i], files))
+				files.push_back(argv[i]);
+		}
+		else if (strcmp(argv[i], "-depth") == 0 && has_value)
+			depth = min(max(atoi(argv[++i]), 1), int(Checkers::MAX_SEARCH_DEPTH));
+		else if (strcmp(argv[i], "-nodes") == 0 && has_value)
+			node_limit = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-threads") == 0 && has_value)
+			threads = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-hash") == 0 && has_value)
+			hash = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-mistake") == 0 && has_value)
+			settings.mistake = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-blunder") == 0 && has_value)
+			settings.blunder = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-bitbase") == 0 && has_value)
+			bitbase_file = argv[++i];
+		else if (strcmp(argv[i], "-network") == 0 && has_value)
+			network_file = argv[++i];
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	if (depth == 0 && node_limit == 0)
+		depth = DEFAULT_DEPTH;
+	if (hash == 0)
+		hash = DEFAULT_HASH_PER_WORKER * threads;
+	try
+	{
+		ofstream out(argv[1]);
+		if (!out)
+			throw(checkers_error(string("Unable to create output file ") + argv[1]));
+		Bitbase bitbase;
+		NNUE network;
+		if (!bitbase_file.empty())
+			bitbase.load(bitbase_file);
+		if (!network_file.empty())
+			network.load(network_file);
+		// A game is searched by one worker's engine, so its positions share transposition tables
+		vector<unique_ptr<Checkers>> engines;
+		for (int i = 0; i < threads; ++i)
+		{
+			engines.push_back(make_unique<Checkers>());
+			engines.back()->set_hash_size(max<size_t>(hash / threads, 1));
+			engines.back()->set_search_depth(depth != 0 ? int8_t(depth) : Checkers::UNBOUNDED_DEPTH);
+			engines.back()->set_time_limit(1e9f); // Only depth or node budget limits the search
+			engines.back()->set_node_limit(node_limit);
+			engines.back()->set_bitbase(&bitbase);
+			engines.back()->set_network(&network);
+		}
+		const auto start_time = chrono::steady_clock::now();
+		vector<string> reports(files.size());
+		{
+			// Games go to the pool from the longest file, so that a long game doesn't finish the run alone
+			vector<size_t> order(files.size());
+			vector<streamoff> sizes(files.size());
+			for (size_t i = 0; i < files.size(); ++i)
+			{
+				order[i] = i;
+				sizes[i] = ifstream(files[i], ios::ate).tellg();
+			}
+			stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+			TaskPool pool(threads);
+			for (size_t i : order)
+				pool.submit([&, i](int worker) { reports[i] = annotate(*engines[worker], files[i], settings); });
+		} // Pool's destructor waits for all games
+		for (const string& report : reports)
+			out << report;
+		const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+		cout << "Done. " << files.size() << " games (" << positions << " positions) are annotated in " << seconds
+			<< " s, report is written to " << argv[1] << '\n';
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
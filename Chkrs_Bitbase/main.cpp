@@ -0,0 +1,43 @@
+// Checkers bitbase generator
+// Generates win/draw/loss bitbase for positions with small piece count
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/bitbase.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+
+constexpr const char* BITBASE_FILES[GAME_RULES_COUNT] = { "bitbase_default.bin", "bitbase_english.bin" };
+
+int main(void)
+{
+	int rules, pieces;
+	cout << "Enter rules (0 - default, 1 - english): ";
+	cin >> rules;
+	cout << "Enter maximum piece count (2-" << Bitbase::MAX_PIECES << "): ";
+	cin >> pieces;
+	if (rules != RULES_DEFAULT && rules != RULES_ENGLISH)
+	{
+		cout << "Rules are wrong\n";
+		return 1;
+	}
+	Bitbase bitbase;
+	try
+	{
+		auto start_time = chrono::high_resolution_clock::now();
+		bitbase.generate(static_cast<game_rules>(rules), pieces, &cout);
+		auto end_time = chrono::high_resolution_clock::now();
+		bitbase.save(BITBASE_FILES[rules]);
+		cout << "Bitbase (" << bitbase.get_size() << " bytes) is saved to " << BITBASE_FILES[rules] << ". "
+			<< chrono::duration_cast<chrono::milliseconds>(end_time - start_time).count() << " ms elapsed.\n";
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+// Checkers opening book builder
+// Builds binary opening book from game files and engine self-play
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/book.h"
+#include "engine/game_db.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+constexpr int DEFAULT_BOOK_PLY = 24; // Default maximum ply of positions in the book
+constexpr int DEFAULT_SELFPLAY_DEPTH = 8; // Default search depth in self-play games
+constexpr int DEFAULT_RANDOM_PLIES = 4; // Default count of random opening plies in self-play games
+constexpr int MAX_GAME_PLY = 500; // Self-play games which are longer are adjudicated as draws
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_BookBuilder <book file> [options] [game files...]\n"
+		"Options:\n"
+		"  -english         build book for english rules\n"
+		"  -misere          build book for misere games\n"
+		"  -merge <file>    merge statistics of existing book (also used in self-play)\n"
+		"  -db <file>       add games of binary game database (see Chkrs_GameDB)\n"
+		"  -ply <n>         maximum ply of book positions (default " << DEFAULT_BOOK_PLY << ")\n"
+		"  -min <n>         minimum count of games with a move to keep it (default 1)\n"
+		"  -selfplay <n>    count of self-play games (default 0)\n"
+		"  -depth <n>       search depth in self-play games (default " << DEFAULT_SELFPLAY_DEPTH << ")\n"
+		"  -random <n>      count of random opening plies in self-play games (default "
+		<< DEFAULT_RANDOM_PLIES << ")\n"
+		"Game files are in the format of saved games of Checkers\n";
+}
+
+// Reads game in the text format of Checkers::save_game
+void read_game(istream& in, game_rules& rules, bool& misere, vector<Move>& game)
+{
+	Move move;
+	game.clear();
+	Board::read_rules(in, rules, misere);
+	while (Board::read_move(in, move))
+		game.push_back(move);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		usage();
+		return 1;
+	}
+	const string book_file = argv[1];
+	game_rules rules = RULES_DEFAULT;
+	bool misere = false;
+	string merge_file, db_file;
+	int max_ply = DEFAULT_BOOK_PLY, min_games = 1, selfplay = 0;
+	int depth = DEFAULT_SELFPLAY_DEPTH, random_plies = DEFAULT_RANDOM_PLIES;
+	vector<string> game_files;
+	for (int i = 2; i < argc; ++i)
+	{
+		const bool has_value = (i + 1 < argc);
+		if (strcmp(argv[i], "-english") == 0)
+			rules = RULES_ENGLISH;
+		else if (strcmp(argv[i], "-misere") == 0)
+			misere = true;
+		else if (strcmp(argv[i], "-merge") == 0 && has_value)
+			merge_file = argv[++i];
+		else if (strcmp(argv[i], "-db") == 0 && has_value)
+			db_file = argv[++i];
+		else if (strcmp(argv[i], "-ply") == 0 && has_value)
+			max_ply = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-min") == 0 && has_value)
+			min_games = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-selfplay") == 0 && has_value)
+			selfplay = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-depth") == 0 && has_value)
+			depth = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-random") == 0 && has_value)
+			random_plies = atoi(argv[++i]);
+		else if (argv[i][0] == '-')
+		{
+			usage();
+			return 1;
+		}
+		else
+			game_files.push_back(argv[i]);
+	}
+	BookBuilder builder(rules, misere);
+	OpeningBook merged;
+	try
+	{
+		if (!merge_file.empty())
+		{
+			merged.open(merge_file);
+			builder.add_book(merged);
+			cout << "Merged " << merged.size() << " entries from " << merge_file << '\n';
+		}
+		// Games from files
+		vector<Move> game;
+		int added = 0;
+		for (const auto& file_name : game_files)
+		{
+			ifstream in(file_name);
+			game_rules game_rule;
+			bool game_misere;
+			try
+			{
+				if (!in)
+					throw(checkers_error("Unable to open file"));
+				read_game(in, game_rule, game_misere, game);
+			}
+			catch (const checkers_error& err)
+			{
+				cout << file_name << ": " << err.what() << '\n';
+				continue;
+			}
+			if (game_rule != rules || game_misere != misere)
+				cout << file_name << ": Game has different rules\n";
+			else if (!builder.add_game(game, max_ply))
+				cout << file_name << ": Game contains an illegal move\n";
+			else
+				++added;
+		}
+		cout << "Added " << added << " games from files\n";
+		// Games from database (ones with other rules are skipped)
+		if (!db_file.empty())
+		{
+			GameDatabase db;
+			db.open(db_file);
+			added = 0;
+			for (size_t i = 0; i < db.size(); ++i)
+			{
+				const GameRecord record = db.get_record(i);
+				if (bool(record.flags & GameRecord::GRF_ENGLISH) != (rules == RULES_ENGLISH)
+					|| bool(record.flags & GameRecord::GRF_MISERE) != misere)
+					continue;
+				game_rules game_rule;
+				bool game_misere;
+				db.get_game(i, game_rule, game_misere, game);
+				if (builder.add_game(game, max_ply, game_state(record.result)))
+					++added;
+			}
+			cout << "Added " << added << " games from " << db_file << '\n';
+		}
+		// Self-play games
+		auto engine = make_unique<Checkers>(rules, misere);
+		engine->set_search_depth(depth);
+		engine->set_time_limit(1e9f);
+		if (merged.is_open())
+			engine->set_book(&merged);
+		mt19937 gen(random_device{}());
+		int results[4] = {};
+		for (int cur_game = 1; cur_game <= selfplay; ++cur_game)
+		{
+			engine->restart(rules, misere);
+			game.clear();
+			while (engine->get_state() == GAME_CONTINUE && game.size() < MAX_GAME_PLY)
+			{
+				if (game.size() < size_t(random_plies))
+				{
+					Move move = engine->get_part_possible_moves()[uniform_int_distribution<size_t>(
+						0, engine->get_part_possible_moves().size() - 1)(gen)];
+					engine->move(move);
+				}
+				else
+					engine->perform_computer_move();
+				if (engine->get_current_ply() > int(game.size()))
+					game.push_back(engine->get_last_move());
+			}
+			const game_state result = (engine->get_state() == GAME_CONTINUE ? DRAW : engine->get_state());
+			++results[result];
+			builder.add_game(game, max_ply, result);
+			if (cur_game % 10 == 0 || cur_game == selfplay)
+				cout << "Self-play games: " << cur_game << " (+" << results[WHITE_WIN] << " =" << results[DRAW]
+					<< " -" << results[BLACK_WIN] << ")\n";
+		}
+		merged.close();
+		const size_t saved = builder.save(book_file, min_games);
+		cout << "Book with " << saved << " moves is saved to " << book_file << '\n';
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,847 @@
+// Checkers DXP server
+// Plays games with other programs over TCP using DXP (Draughts eXchange Protocol) messages
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/search_pool.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+typedef SOCKET socket_t;
+#define poll WSAPoll
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+typedef int socket_t;
+constexpr socket_t INVALID_SOCKET = -1;
+#endif
+
+using namespace std;
+
+constexpr const char* ENGINE_NAME = "Checkers 1.8";
+constexpr int DXP_VERSION = 1;
+constexpr int NAME_LENGTH = 32; // Length of name field of GAMEREQ and GAMEACC messages
+constexpr int FIELD_COUNT = 32; // Fields are numbered 1-32 from black's side, left to right from white's view
+constexpr int DEFAULT_PORT = 27531;
+constexpr size_t MAX_MESSAGE_SIZE = 1024; // Longer messages mean that the peer doesn't speak DXP
+constexpr int MIN_MOVES_TO_GO = 10; // Minimal expected count of remaining moves when allocating time
+constexpr float MIN_MOVE_TIME = 50.0f; // Minimal time allocated for a move, ms
+constexpr size_t RECEIVE_BUFFER_SIZE = 4096;
+
+// DXP message types
+constexpr char MSG_CHAT = 'C';
+constexpr char MSG_GAMEREQ = 'R';
+constexpr char MSG_GAMEACC = 'A';
+constexpr char MSG_MOVE = 'M';
+constexpr char MSG_GAMEEND = 'E';
+constexpr char MSG_BACKREQ = 'B';
+constexpr char MSG_BACKACC = 'K';
+
+// GAMEACC acceptance codes
+constexpr char ACC_ACCEPTED = '0';
+constexpr char ACC_NOT_WITH_POSITION = '3';
+constexpr char ACC_DENIED = '9';
+
+// GAMEEND reasons (from the point of view of the sender)
+enum end_reason : int8_t { END_UNKNOWN = 0, END_LOSS, END_DRAW, END_WIN };
+
+struct Settings
+{
+	game_rules rules = RULES_DEFAULT;
+	bool misere = false;
+	int workers = max<int>(thread::hardware_concurrency(), 1); // Count of engines which search for all games
+	size_t hash_size = 0; // Size of transposition tables of each worker, MB (0 means default)
+	int8_t depth = Checkers::UNBOUNDED_DEPTH;
+	// Initiator settings
+	int games = 2; // Count of games played over each connection
+	int time = 5; // Thinking time, minutes
+	int moves = 50; // Count of moves for the thinking time
+};
+
+// Game results of initiated games from engine's point of view
+struct Score
+{
+	int wins = 0, draws = 0, losses = 0;
+};
+
+// Helpers for non-blocking sockets
+namespace
+{
+	void close_socket(socket_t sock)
+	{
+#ifdef _WIN32
+		closesocket(sock);
+#else
+		::close(sock);
+#endif
+	}
+
+	void set_nonblocking(socket_t sock)
+	{
+#ifdef _WIN32
+		u_long mode = 1;
+		ioctlsocket(sock, FIONBIO, &mode);
+#else
+		fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+		const int flag = 1;
+		setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&flag), sizeof(flag));
+	}
+
+	bool would_block(void)
+	{
+#ifdef _WIN32
+		return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+		return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+	}
+
+	socket_t open_listener(const char* address, int port)
+	{
+		const socket_t sock = socket(AF_INET, SOCK_STREAM, 0);
+		if (sock == INVALID_SOCKET)
+			throw(checkers_error("Unable to create socket"));
+		const int flag = 1;
+		setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&flag), sizeof(flag));
+		sockaddr_in addr = {};
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(static_cast<uint16_t>(port));
+		inet_pton(AF_INET, address, &addr.sin_addr);
+		if (::bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(sock, SOMAXCONN) != 0)
+		{
+			close_socket(sock);
+			throw(checkers_error("Unable to listen on port " + to_string(port)));
+		}
+		return sock;
+	}
+
+	socket_t connect_to(const string& host, int port)
+	{
+		addrinfo hints = {}, *info;
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_STREAM;
+		if (getaddrinfo(host.c_str(), to_string(port).c_str(), &hints, &info) != 0)
+			throw(checkers_error("Unable to resolve " + host));
+		const socket_t sock = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+		const bool connected = (sock != INVALID_SOCKET && connect(sock, info->ai_addr, int(info->ai_addrlen)) == 0);
+		freeaddrinfo(info);
+		if (!connected)
+		{
+			if (sock != INVALID_SOCKET)
+				close_socket(sock);
+			throw(checkers_error("Unable to connect to " + host + ":" + to_string(port)));
+		}
+		set_nonblocking(sock);
+		return sock;
+	}
+
+	// Field number of a square
+	inline int field(Position pos)
+	{
+		return ((7 - pos.get_row()) << 2) + (pos.get_column() >> 1) + 1;
+	}
+
+	string number(int value, int width)
+	{
+		string str = to_string(value);
+		return str.size() >= size_t(width) ? str.substr(str.size() - width) : string(width - str.size(), '0') + str;
+	}
+}
+
+class Server;
+
+// Connection with a DXP peer. Plays at most one game at a time, whose searches are run by the server's pool
+class Session
+{
+public:
+	Session(Server&, int, socket_t, bool);
+	inline int get_id(void) const noexcept { return id; }
+	inline socket_t get_socket(void) const noexcept { return sock; }
+	inline bool wants_write(void) const noexcept { return !output.empty(); }
+	inline bool is_closed(void) const noexcept { return closed; }
+	void start(void); // Called when the connection is established
+	void on_readable(void); // Receives available data and handles complete messages
+	void on_writable(void); // Sends buffered data
+	void on_search_result(unsigned, const SearchResult&); // Called in the event loop when a search finishes
+	void close(void);
+	void close_when_sent(void); // Closes the connection after buffered data is sent
+private:
+	void handle(const string&);
+	void on_gamereq(const string&);
+	void on_gameacc(const string&);
+	void on_move(const string&);
+	void on_gameend(const string&);
+	void on_backreq(const string&);
+	void send(const string&);
+	void request_game(void);
+	void start_game(colour, int, int);
+	void think(void); // Starts search if it's engine's turn
+	void cancel_search(void); // Discards the result of current search
+	inline uint64_t game_key(void) const noexcept; // Identifier of the current game in the search pool
+	void check_game_end(void);
+	void send_gameend(end_reason);
+	void finish_game(void);
+	end_reason result(void) const; // Result of finished game for engine
+	// Members
+	Server& server;
+	const int id;
+	socket_t sock;
+	const bool initiator; // Whether this side requests games
+	bool closed;
+	bool closing; // Whether the connection should be closed when output is sent
+	string input, output;
+	GameBoard board; // Only the game state is kept per connection (engines belong to the pool)
+	bool in_game;
+	bool searching;
+	bool end_sent, end_received; // GAMEEND messages of the current game
+	unsigned generation; // Increased when a search result should be discarded
+	colour engine_colour;
+	int ply; // Count of moves of the current game
+	int moves; // Count of moves for the thinking time
+	float time_left; // Engine's thinking time left, ms
+	int games_played;
+	chrono::steady_clock::time_point search_start;
+};
+
+// Event loop, which multiplexes connections and results of searches
+class Server
+{
+public:
+	Server(const Settings&);
+	~Server(void);
+	void listen(int); // Starts accepting connections on given port
+	void connect(const string&, int); // Initiates games over new connection
+	void run(void); // Runs until there are no connections and nothing is listened
+	void post_result(int, unsigned, const SearchResult&); // Thread-safe, wakes up the loop
+	inline const Settings& get_settings(void) const noexcept { return settings; }
+	inline Score& get_score(void) noexcept { return score; }
+	inline SearchPool& get_pool(void) noexcept { return *pool; }
+private:
+	struct Completion
+	{
+		int session;
+		unsigned generation;
+		SearchResult result;
+	};
+	void process_completions(void);
+	const Settings& settings;
+	Score score;
+	unique_ptr<SearchPool> pool;
+	socket_t listener;
+	socket_t wake_read, wake_write; // Loopback pair for waking up poll from search threads
+	vector<unique_ptr<Session>> sessions;
+	int next_id;
+	mutex completion_mutex;
+	vector<Completion> completions;
+};
+
+Session::Session(Server& srv, int sid, socket_t s, bool init)
+	: server(srv), id(sid), sock(s), initiator(init), closed(false), closing(false),
+	board(srv.get_settings().rules, srv.get_settings().misere), in_game(false), searching(false), end_sent(false),
+	end_received(false), generation(0), engine_colour(WHITE), ply(0), moves(0), time_left(0), games_played(0)
+{}
+
+inline uint64_t Session::game_key(void) const noexcept
+{
+	return (uint64_t(id) << 32) | uint32_t(games_played);
+}
+
+void Session::start(void)
+{
+	cout << '[' << id << "] Connected" << endl;
+	if (initiator)
+		request_game();
+}
+
+void Session::close(void)
+{
+	if (closed)
+		return;
+	cancel_search();
+	close_socket(sock);
+	closed = true;
+	cout << '[' << id << "] Disconnected" << endl;
+}
+
+void Session::on_readable(void)
+{
+	char buffer[RECEIVE_BUFFER_SIZE];
+	bool disconnected = false;
+	for (;;)
+	{
+		const int received = recv(sock, buffer, sizeof(buffer), 0);
+		if (received <= 0)
+		{
+			disconnected = (received == 0 || !would_block());
+			break;
+		}
+		input.append(buffer, received);
+	}
+	// Messages are terminated by zero characters. Ones received before disconnection are still handled
+	size_t begin = 0;
+	for (size_t end; !closed && (end = input.find('\0', begin)) != string::npos; begin = end + 1)
+		handle(input.substr(begin, end - begin));
+	input.erase(0, begin);
+	if (disconnected || input.size() > MAX_MESSAGE_SIZE)
+		close();
+}
+
+void Session::on_writable(void)
+{
+	while (!output.empty() && !closed)
+	{
+		const int sent = ::send(sock, output.data(), int(output.size()), 0);
+		if (sent < 0)
+		{
+			if (!would_block())
+				close();
+			return;
+		}
+		output.erase(0, sent);
+	}
+	if (closing && output.empty())
+		close();
+}
+
+void Session::close_when_sent(void)
+{
+	closing = true;
+	on_writable();
+}
+
+void Session::send(const string& msg)
+{
+	output += msg;
+	output += '\0';
+	on_writable();
+}
+
+void Session::handle(const string& msg)
+{
+	if (msg.empty())
+		return;
+	try
+	{
+		switch (msg[0])
+		{
+		case MSG_CHAT:
+			cout << '[' << id << "] Chat: " << msg.substr(1) << endl;
+			break;
+		case MSG_GAMEREQ:
+			on_gamereq(msg);
+			break;
+		case MSG_GAMEACC:
+			on_gameacc(msg);
+			break;
+		case MSG_MOVE:
+			on_move(msg);
+			break;
+		case MSG_GAMEEND:
+			on_gameend(msg);
+			break;
+		case MSG_BACKREQ:
+			on_backreq(msg);
+			break;
+		case MSG_BACKACC:
+			break; // Engine never requests take-backs
+		default:
+			throw(checkers_error("Unknown message " + msg));
+		}
+	}
+	catch (const checkers_error& err)
+	{
+		cout << '[' << id << "] Error: " << err.what() << endl;
+		close();
+	}
+}
+
+// R <version:2> <initiator name:32> <follower colour:W|Z> <time:3> <moves:3> <position:A|B> [<turn> <fields:32>]
+void Session::on_gamereq(const string& msg)
+{
+	const size_t colour_offset = 3 + NAME_LENGTH;
+	if (msg.size() < colour_offset + 8)
+		throw(checkers_error("GAMEREQ message is too short"));
+	const string name = msg.substr(3, NAME_LENGTH);
+	string reply = string(1, MSG_GAMEACC) + ENGINE_NAME;
+	reply.resize(1 + NAME_LENGTH, ' ');
+	if (in_game || initiator)
+	{
+		send(reply + ACC_DENIED);
+		return;
+	}
+	// Setup positions are not supported yet, games start from the initial position
+	if (msg[colour_offset + 7] != 'A')
+	{
+		send(reply + ACC_NOT_WITH_POSITION);
+		return;
+	}
+	send(reply + ACC_ACCEPTED);
+	cout << '[' << id << "] Game requested by " << name.substr(0, name.find_last_not_of(' ') + 1) << endl;
+	start_game(msg[colour_offset] == 'W' ? WHITE : BLACK, atoi(msg.substr(colour_offset + 1, 3).c_str()),
+		atoi(msg.substr(colour_offset + 4, 3).c_str()));
+}
+
+// A <follower name:32> <acceptance code:1>
+void Session::on_gameacc(const string& msg)
+{
+	if (!initiator || in_game)
+		return;
+	if (msg.size() < 2 + NAME_LENGTH || msg[1 + NAME_LENGTH] != ACC_ACCEPTED)
+	{
+		cout << '[' << id << "] Game request was declined" << endl;
+		close();
+		return;
+	}
+	const Settings& settings = server.get_settings();
+	start_game(games_played % 2 == 0 ? WHITE : BLACK, settings.time, settings.moves);
+}
+
+// M <time:4> <from:2> <to:2> <captured count:2> <captured fields:2 each>
+void Session::on_move(const string& msg)
+{
+	if (!in_game || end_sent || searching || board.current_turn_colour() == engine_colour)
+		throw(checkers_error("Unexpected move"));
+	if (msg.size() < 11)
+		throw(checkers_error("MOVE message is too short"));
+	const int from = atoi(msg.substr(5, 2).c_str()), to = atoi(msg.substr(7, 2).c_str()),
+		capt_count = atoi(msg.substr(9, 2).c_str());
+	if (msg.size() < 11 + 2 * size_t(capt_count))
+		throw(checkers_error("MOVE message is too short"));
+	vector<int> captured(capt_count);
+	for (int i = 0; i < capt_count; ++i)
+		captured[i] = atoi(msg.substr(11 + 2 * i, 2).c_str());
+	if (from < 1 || from > FIELD_COUNT || to < 1 || to > FIELD_COUNT)
+		throw(checkers_error("Wrong field in move " + msg));
+	// DXP moves don't contain intermediate squares, so the move is identified by its ends and captured pieces
+	vector<Move> legal;
+	board.get_all_moves(legal);
+	for (Move& move : legal)
+	{
+		if (field(move.old_pos()) != from || field(move.new_pos()) != to || move.capt_size() != capt_count)
+			continue;
+		bool match = true;
+		for (const auto& capture : move.get_captured())
+			match = match && find(captured.begin(), captured.end(), field(capture.first)) != captured.end();
+		if (match)
+		{
+			board.move(move);
+			++ply;
+			check_game_end();
+			think();
+			return;
+		}
+	}
+	throw(checkers_error("Illegal move " + msg));
+}
+
+// E <reason:1> <stop code:1>
+void Session::on_gameend(const string& msg)
+{
+	if (!in_game)
+		return;
+	end_received = true;
+	if (!end_sent)
+	{
+		cancel_search();
+		send_gameend(board.get_state() == GAME_CONTINUE ? END_UNKNOWN : result());
+	}
+	finish_game();
+	if (msg.size() >= 3 && msg[2] == '1' && !initiator)
+		close_when_sent();
+}
+
+// B <move number:3> <colour to move:W|Z>
+void Session::on_backreq(const string& msg)
+{
+	if (msg.size() < 5)
+		throw(checkers_error("BACKREQ message is too short"));
+	const int target = (atoi(msg.substr(1, 3).c_str()) - 1) * 2 + (msg[4] == 'Z' ? 1 : 0);
+	if (!in_game || end_sent || target < 0 || target > ply)
+	{
+		send(string(1, MSG_BACKACC) + '1');
+		return;
+	}
+	cancel_search();
+	board.undo_moves(ply - target);
+	ply = target;
+	send(string(1, MSG_BACKACC) + '0');
+	think();
+}
+
+void Session::request_game(void)
+{
+	const Settings& settings = server.get_settings();
+	string msg = string(1, MSG_GAMEREQ) + number(DXP_VERSION, 2) + ENGINE_NAME;
+	msg.resize(3 + NAME_LENGTH, ' ');
+	// Engine alternates colours, the follower gets the other one
+	msg += (games_played % 2 == 0 ? 'Z' : 'W');
+	msg += number(settings.time, 3) + number(settings.moves, 3) + 'A';
+	send(msg);
+}
+
+void Session::start_game(colour col, int time, int move_count)
+{
+	const Settings& settings = server.get_settings();
+	board.restart(settings.rules, settings.misere);
+	in_game = true;
+	end_sent = end_received = false;
+	engine_colour = col;
+	ply = 0;
+	moves = max(move_count, 1);
+	time_left = max(time, 1) * 60000.0f;
+	cout << '[' << id << "] Game started, engine plays " << (col == WHITE ? "white" : "black") << endl;
+	think();
+}
+
+void Session::think(void)
+{
+	if (!in_game || end_sent || searching || board.get_state() != GAME_CONTINUE
+		|| board.current_turn_colour() != engine_colour)
+		return;
+	// Time is allocated evenly for expected remaining moves of the period
+	const int engine_moves = ply / 2;
+	const int moves_to_go = max(moves - engine_moves % moves, MIN_MOVES_TO_GO);
+	const Settings& settings = server.get_settings();
+	searching = true;
+	search_start = chrono::steady_clock::now();
+	Server& srv = server;
+	const int sid = id;
+	const unsigned gen = generation;
+	server.get_pool().submit({ game_key(), settings.rules, settings.misere, board.get_moves(), settings.depth,
+		max(time_left / moves_to_go, MIN_MOVE_TIME), 0,
+		[&srv, sid, gen](const SearchResult& result) { srv.post_result(sid, gen, result); } });
+}
+
+void Session::cancel_search(void)
+{
+	if (!searching)
+		return;
+	++generation;
+	searching = false;
+	server.get_pool().cancel(game_key());
+}
+
+void Session::on_search_result(unsigned gen, const SearchResult& search_result)
+{
+	if (gen != generation || !searching)
+		return;
+	searching = false;
+	const float elapsed = chrono::duration<float, milli>(chrono::steady_clock::now() - search_start).count();
+	time_left = max(time_left - elapsed, 0.0f);
+	Move move = search_result.move;
+	if (move.size() == 0)
+	{
+		check_game_end();
+		return;
+	}
+	string msg = string(1, MSG_MOVE) + number(int(elapsed / 1000.0f + 0.5f), 4)
+		+ number(field(move.old_pos()), 2) + number(field(move.new_pos()), 2) + number(move.capt_size(), 2);
+	for (const auto& capture : move.get_captured())
+		msg += number(field(capture.first), 2);
+	send(msg);
+	board.move(move);
+	++ply;
+	check_game_end();
+}
+
+void Session::check_game_end(void)
+{
+	if (board.get_state() != GAME_CONTINUE && !end_sent)
+		send_gameend(result());
+}
+
+end_reason Session::result(void) const
+{
+	const game_state state = board.get_state();
+	if (state == DRAW)
+		return END_DRAW;
+	return (state == WHITE_WIN) == (engine_colour == WHITE) ? END_WIN : END_LOSS;
+}
+
+void Session::send_gameend(end_reason reason)
+{
+	end_sent = true;
+	const bool last = initiator && games_played + 1 >= server.get_settings().games;
+	send(string(1, MSG_GAMEEND) + char('0' + reason) + (last ? '1' : '0'));
+	finish_game();
+}
+
+// Game is finished when both sides have sent GAMEEND
+void Session::finish_game(void)
+{
+	if (!end_sent || !end_received || !in_game)
+		return;
+	in_game = false;
+	++games_played;
+	const char* const RESULT_NAME[] = { "unknown", "loss", "draw", "win" };
+	const end_reason res = (board.get_state() == GAME_CONTINUE ? END_UNKNOWN : result());
+	cout << '[' << id << "] Game " << games_played << " finished after " << ply << " plies: "
+		<< RESULT_NAME[res] << endl;
+	if (!initiator)
+		return;
+	Score& score = server.get_score();
+	if (res == END_WIN)
+		++score.wins;
+	else if (res == END_LOSS)
+		++score.losses;
+	else if (res == END_DRAW)
+		++score.draws;
+	if (games_played < server.get_settings().games)
+		request_game();
+	else
+		close_when_sent();
+}
+
+Server::Server(const Settings& sett)
+	: settings(sett), pool(make_unique<SearchPool>(sett.workers, sett.hash_size)), listener(INVALID_SOCKET), next_id(1)
+{
+	// Loopback connection whose read end is polled together with sessions
+	const socket_t wake_listener = open_listener("127.0.0.1", 0);
+	sockaddr_in addr = {};
+	socklen_t addr_size = sizeof(addr);
+	getsockname(wake_listener, reinterpret_cast<sockaddr*>(&addr), &addr_size);
+	wake_write = connect_to("127.0.0.1", ntohs(addr.sin_port));
+	wake_read = accept(wake_listener, nullptr, nullptr);
+	close_socket(wake_listener);
+	if (wake_read == INVALID_SOCKET)
+		throw(checkers_error("Unable to create wake-up connection"));
+	set_nonblocking(wake_read);
+}
+
+Server::~Server(void)
+{
+	pool.reset(); // Workers report results to the server, so they are stopped first
+	sessions.clear();
+	if (listener != INVALID_SOCKET)
+		close_socket(listener);
+	close_socket(wake_read);
+	close_socket(wake_write);
+}
+
+void Server::listen(int port)
+{
+	listener = open_listener("0.0.0.0", port);
+	set_nonblocking(listener);
+	cout << "Listening on port " << port << endl;
+}
+
+void Server::connect(const string& host, int port)
+{
+	sessions.push_back(make_unique<Session>(*this, next_id++, connect_to(host, port), true));
+	sessions.back()->start();
+}
+
+void Server::post_result(int session, unsigned generation, const SearchResult& result)
+{
+	{
+		lock_guard<mutex> lock(completion_mutex);
+		completions.push_back({ session, generation, result });
+	}
+	const char signal = 1;
+	::send(wake_write, &signal, 1, 0);
+}
+
+void Server::process_completions(void)
+{
+	char buffer[RECEIVE_BUFFER_SIZE];
+	while (recv(wake_read, buffer, sizeof(buffer), 0) > 0);
+	vector<Completion> finished;
+	{
+		lock_guard<mutex> lock(completion_mutex);
+		finished.swap(completions);
+	}
+	for (const Completion& completion : finished)
+		for (auto& session : sessions)
+			if (session->get_id() == completion.session && !session->is_closed())
+				session->on_search_result(completion.generation, completion.result);
+}
+
+void Server::run(void)
+{
+	vector<pollfd> fds;
+	while (listener != INVALID_SOCKET || !sessions.empty())
+	{
+		fds.clear();
+		fds.push_back({ wake_read, POLLIN, 0 });
+		if (listener != INVALID_SOCKET)
+			fds.push_back({ listener, POLLIN, 0 });
+		const size_t first_session = fds.size(), session_count = sessions.size();
+		for (const auto& session : sessions)
+			fds.push_back({ session->get_socket(), short(POLLIN | (session->wants_write() ? POLLOUT : 0)), 0 });
+		if (poll(fds.data(), static_cast<decltype(fds.size())>(fds.size()), -1) < 0)
+		{
+#ifndef _WIN32
+			if (errno == EINTR)
+				continue;
+#endif
+			throw(checkers_error("Polling failed"));
+		}
+		if (fds[0].revents & POLLIN)
+			process_completions();
+		for (size_t i = 0; i < session_count; ++i)
+		{
+			Session& session = *sessions[i];
+			const short events = fds[first_session + i].revents;
+			if (!session.is_closed() && (events & (POLLIN | POLLHUP | POLLERR)))
+				session.on_readable();
+			if (!session.is_closed() && (events & POLLOUT))
+				session.on_writable();
+		}
+		if (listener != INVALID_SOCKET && (fds[1].revents & POLLIN))
+			for (socket_t sock; (sock = accept(listener, nullptr, nullptr)) != INVALID_SOCKET; )
+			{
+				set_nonblocking(sock);
+				sessions.push_back(make_unique<Session>(*this, next_id++, sock, false));
+				sessions.back()->start();
+			}
+		// Closed sessions are destroyed. Their searches may still run (cancel only requests a stop), but completion
+		// callbacks capture the server and session id, and results for ids which are gone are dropped by the loop
+		for (size_t i = 0; i < sessions.size(); )
+			if (sessions[i]->is_closed())
+				sessions.erase(sessions.begin() + i);
+			else
+				++i;
+	}
+}
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_DXP [options]\n"
+		"Accepts DXP games (by default) or initiates them\n"
+		"Options:\n"
+		"  -listen <port>         accept connections on given port (default " << DEFAULT_PORT << ")\n"
+		"  -connect <host> <port> initiate games over given number of connections to host\n"
+		"  -connections <n>       count of concurrent connections to initiate (default 1)\n"
+		"  -games <n>             count of games over each initiated connection (default 2)\n"
+		"  -time <min> <moves>    thinking time of initiated games (default 5 minutes per 50 moves)\n"
+		"  -workers <n>           count of engines searching for all games (default is count of cores)\n"
+		"  -hash <MB>             size of transposition tables of each worker\n"
+		"  -depth <n>             maximum search depth\n"
+		"  -english               use english rules\n"
+		"  -misere                play misere (giveaway) games\n"
+		"  -bitbase <file>        endgame bitbase\n"
+		"  -network <file>        evaluation network\n"
+		"  -eval <file>           evaluation parameters\n"
+		"  -search <file>         search parameters\n";
+}
+
+int main(int argc, char* argv[])
+{
+	Settings settings;
+	int port = DEFAULT_PORT, connections = 1;
+	string host, bitbase_file, network_file, eval_file, search_file;
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool has_value = (i + 1 < argc);
+		if (strcmp(argv[i], "-listen") == 0 && has_value)
+			port = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-connect") == 0 && i + 2 < argc)
+			host = argv[++i], port = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-connections") == 0 && has_value)
+			connections = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-games") == 0 && has_value)
+			settings.games = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-time") == 0 && i + 2 < argc)
+			settings.time = atoi(argv[++i]), settings.moves = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-workers") == 0 && has_value)
+			settings.workers = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-hash") == 0 && has_value)
+			settings.hash_size = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-depth") == 0 && has_value)
+			settings.depth = int8_t(min(max(atoi(argv[++i]), 1), int(Checkers::MAX_SEARCH_DEPTH)));
+		else if (strcmp(argv[i], "-english") == 0)
+			settings.rules = RULES_ENGLISH;
+		else if (strcmp(argv[i], "-misere") == 0)
+			settings.misere = true;
+		else if (strcmp(argv[i], "-bitbase") == 0 && has_value)
+			bitbase_file = argv[++i];
+		else if (strcmp(argv[i], "-network") == 0 && has_value)
+			network_file = argv[++i];
+		else if (strcmp(argv[i], "-eval") == 0 && has_value)
+			eval_file = argv[++i];
+		else if (strcmp(argv[i], "-search") == 0 && has_value)
+			search_file = argv[++i];
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+#ifdef _WIN32
+	WSADATA wsa_data;
+	if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+	{
+		cout << "Unable to initialize sockets" << endl;
+		return 1;
+	}
+#else
+	signal(SIGPIPE, SIG_IGN);
+#endif
+	try
+	{
+		Bitbase bitbase;
+		NNUE network;
+		EvalParams eval_params;
+		SearchParams search_params;
+		if (!bitbase_file.empty())
+			bitbase.load(bitbase_file);
+		if (!network_file.empty())
+			network.load(network_file);
+		if (!eval_file.empty())
+			eval_params.load(eval_file);
+		if (!search_file.empty())
+			search_params.load(search_file);
+		Server server(settings);
+		server.get_pool().configure([&](Checkers& engine) {
+			engine.set_bitbase(&bitbase);
+			engine.set_network(&network);
+			engine.set_eval_params(eval_params);
+			engine.set_search_params(search_params);
+		});
+		if (host.empty())
+			server.listen(port);
+		else
+			for (int i = 0; i < connections; ++i)
+				server.connect(host, port);
+		server.run();
+		if (!host.empty())
+		{
+			const Score& score = server.get_score();
+			cout << "Score: +" << score.wins << " =" << score.draws << " -" << score.losses << endl;
+		}
+	}
+	catch (const checkers_error& err)
+	{
+		cout << "Error: " << err.what() << endl;
+		return 1;
+	}
+#ifdef _WIN32
+	WSACleanup();
+#endif
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+// Checkers training data generator
+// Plays engine-vs-engine games and records quiet positions labelled with search scores and game results
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/training_data.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+constexpr uint64_t DEFAULT_NODE_LIMIT = 5000; // Default node budget per move
+constexpr int DEFAULT_RANDOM_PLIES = 8; // Default count of random opening plies
+constexpr int MAX_GAME_PLY = 400; // Longer games are adjudicated as draws
+constexpr int16_t MAX_RECORD_SCORE = 3000; // Positions with decisive scores are not recorded
+constexpr size_t FLUSH_SIZE = 4096; // Count of records buffered by each thread before writing
+
+struct Settings
+{
+	game_rules rules = RULES_DEFAULT;
+	bool misere = false;
+	int games = 1000;
+	uint64_t node_limit = DEFAULT_NODE_LIMIT;
+	int random_plies = DEFAULT_RANDOM_PLIES;
+};
+
+atomic<int> next_game(0), finished_games(0), active_threads(0);
+atomic<uint64_t> positions(0);
+mutex error_mutex;
+string worker_error; // First error of worker threads (it is reported by main thread)
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_DataGen <output file> [options]\n"
+		"Options:\n"
+		"  -games <n>       count of games (default 1000)\n"
+		"  -threads <n>     count of threads (default is count of cores)\n"
+		"  -nodes <n>       node budget per move (default " << DEFAULT_NODE_LIMIT << ")\n"
+		"  -random <n>      count of random opening plies (default " << DEFAULT_RANDOM_PLIES << ")\n"
+		"  -english         play by english rules\n"
+		"  -misere          play misere games\n"
+		"  -append          append to existing output file\n"
+		"  -bitbase <file>  use given bitbase\n"
+		"  -network <file>  use given network for evaluation\n";
+}
+
+// Plays games until all are taken by threads, writing their positions to given writer
+void play_games(Checkers& engine, const Settings& settings, TrainingDataWriter& writer, unsigned seed)
+{
+	mt19937 gen(seed);
+	vector<TrainingRecord> buffer, game_records;
+	try
+	{
+		while (next_game++ < settings.games)
+		{
+			engine.restart(settings.rules, settings.misere);
+			// Randomized opening (odd and even ply counts alternate, so that both sides start the game)
+			const int random_plies = settings.random_plies + int(gen() & 1);
+			for (int ply = 0; ply < random_plies && engine.get_state() == GAME_CONTINUE; ++ply)
+			{
+				const auto& moves = engine.get_part_possible_moves();
+				Move move = moves[uniform_int_distribution<size_t>(0, moves.size() - 1)(gen)];
+				engine.move(move);
+			}
+			// Engine plays the rest
+			game_records.clear();
+			bool aborted = false;
+			while (engine.get_state() == GAME_CONTINUE && engine.get_current_ply() < MAX_GAME_PLY)
+			{
+				const colour turn = engine.current_turn_colour();
+				const bool quiet = (engine.get_part_possible_moves()[0].capt_size() == 0);
+				Move move;
+				int score;
+				if (engine.get_computer_move(move, score) == 0)
+				{
+					// Either the game has ended or budget didn't allow to finish even the first iteration
+					aborted = (engine.get_state() == GAME_CONTINUE);
+					break;
+				}
+				if (quiet && abs(score) < MAX_RECORD_SCORE)
+				{
+					game_records.emplace_back();
+					game_records.back().set(engine, turn, int16_t(score), 0);
+				}
+				engine.move(move);
+			}
+			if (aborted)
+				continue;
+			// Label positions with the result
+			const game_state state = engine.get_state();
+			for (auto& record : game_records)
+				record.result = (state == WHITE_WIN ? 1 : state == BLACK_WIN ? -1 : 0) * (record.turn() == WHITE ? 1 : -1);
+			buffer.insert(buffer.end(), game_records.begin(), game_records.end());
+			if (buffer.size() >= FLUSH_SIZE)
+			{
+				writer.write(buffer.data(), buffer.size());
+				buffer.clear();
+			}
+			positions += game_records.size();
+			++finished_games;
+		}
+		writer.write(buffer.data(), buffer.size());
+	}
+	catch (const checkers_error& err)
+	{
+		// Other threads stop after their current games (records of unfinished games are lost anyway)
+		next_game = settings.games;
+		lock_guard<mutex> lock(error_mutex);
+		if (worker_error.empty())
+			worker_error = err.what();
+	}
+	--active_threads;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		usage();
+		return 1;
+	}
+	Settings settings;
+	int threads = max<int>(thread::hardware_concurrency(), 1);
+	bool append = false;
+	string bitbase_file, network_file;
+	for (int i = 2; i < argc; ++i)
+	{
+		const bool has_value = (i + 1 < argc);
+		if (strcmp(argv[i], "-games") == 0 && has_value)
+			settings.games = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-threads") == 0 && has_value)
+			threads = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-nodes") == 0 && has_value)
+			settings.node_limit = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-random") == 0 && has_value)
+			settings.random_plies = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-english") == 0)
+			settings.rules = RULES_ENGLISH;
+		else if (strcmp(argv[i], "-misere") == 0)
+			settings.misere = true;
+		else if (strcmp(argv[i], "-append") == 0)
+			append = true;
+		else if (strcmp(argv[i], "-bitbase") == 0 && has_value)
+			bitbase_file = argv[++i];
+		else if (strcmp(argv[i], "-network") == 0 && has_value)
+			network_file = argv[++i];
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	try
+	{
+		TrainingDataWriter writer(argv[1], append);
+		Bitbase bitbase;
+		NNUE network;
+		if (!bitbase_file.empty())
+			bitbase.load(bitbase_file);
+		if (!network_file.empty())
+			network.load(network_file);
+		// Engines are created before starting threads (each one is big and has its own transposition tables)
+		vector<unique_ptr<Checkers>> engines;
+		for (int i = 0; i < threads; ++i)
+		{
+			engines.push_back(make_unique<Checkers>(settings.rules, settings.misere));
+			engines.back()->set_search_depth(Checkers::UNBOUNDED_DEPTH);
+			engines.back()->set_time_limit(1e9f); // Only node budget limits the search
+			engines.back()->set_node_limit(settings.node_limit);
+			engines.back()->set_bitbase(&bitbase);
+			engines.back()->set_network(&network);
+		}
+		const auto start_time = chrono::steady_clock::now();
+		random_device seeder;
+		vector<thread> workers;
+		active_threads = threads;
+		for (int i = 0; i < threads; ++i)
+			workers.emplace_back(play_games, ref(*engines[i]), cref(settings), ref(writer), seeder());
+		// Report progress while threads are working
+		for (int tick = 1; active_threads > 0; ++tick)
+		{
+			this_thread::sleep_for(chrono::seconds(1));
+			if (tick % 10 != 0)
+				continue;
+			const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+			cout << "Games: " << finished_games << ", positions: " << positions << " ("
+				<< uint64_t(positions / seconds) << " per second)" << endl;
+		}
+		for (auto& worker : workers)
+			worker.join();
+		if (!worker_error.empty())
+			throw(checkers_error(worker_error + " (" + to_string(writer.get_count()) + " positions are written)"));
+		cout << "Done. " << writer.get_count() << " positions from " << finished_games
+			<< " games are written to " << argv[1] << '\n';
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+// Checkers game database tool
+// Imports games into binary game database, exports them to PDN, builds position index and searches positions
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/game_db.h"
+#include "engine/pdn.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+constexpr int DEFAULT_SHOWN_GAMES = 10; // Default count of games shown by find command
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_GameDB <command> <database file> [arguments]\n"
+		"Commands:\n"
+		"  import <files...>           append games from PDN or save_game files\n"
+		"  export <file>               write all games to PDN file\n"
+		"  index [-ply <n>]            build position index (positions after given ply aren't indexed)\n"
+		"  find <position> [options]   show statistics of moves and games with given position, which is\n"
+		"                              a position string, a file in save_board format or 'start' for\n"
+		"                              the initial position\n"
+		"  info                        show count of games and state of the index\n"
+		"Options of find:\n"
+		"  -english         initial position of english rules\n"
+		"  -misere          initial position of misere game\n"
+		"  -moves <moves>   moves played from the position (the rest of arguments)\n"
+		"  -games <n>       count of shown games (default " << DEFAULT_SHOWN_GAMES << ")\n";
+}
+
+string move_str(const Move& move)
+{
+	ostringstream ss;
+	Board::write_move(ss, move);
+	return ss.str();
+}
+
+void import(const string& db_file, int argc, char* argv[])
+{
+	GameDatabaseWriter writer(db_file);
+	const auto start_time = chrono::steady_clock::now();
+	uint64_t errors = 0;
+	PdnGame game;
+	for (int i = 0; i < argc; ++i)
+	{
+		PdnReader reader(argv[i]);
+		for (;;)
+		{
+			try
+			{
+				if (!reader.next(game))
+					break;
+				if (writer.add_game(game))
+					continue;
+				++errors;
+				cout << argv[i] << ", game " << reader.get_game_count() << ": Game contains an illegal move\n";
+			}
+			catch (const checkers_error& err)
+			{
+				++errors;
+				cout << argv[i] << ", game " << reader.get_game_count() << ": " << err.what() << '\n';
+			}
+		}
+	}
+	const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+	cout << "Imported " << writer.get_count() << " games in " << seconds << " s, " << errors << " are skipped\n";
+}
+
+void export_games(const GameDatabase& db, const string& file_name)
+{
+	ofstream out(file_name);
+	if (!out)
+		throw(checkers_error("Unable to create file " + file_name));
+	game_rules rules;
+	bool misere;
+	vector<Move> moves;
+	for (size_t game = 0; game < db.size(); ++game)
+	{
+		db.get_game(game, rules, misere, moves);
+		write_pdn(out, rules, misere, moves, static_cast<game_state>(db.get_record(game).result));
+	}
+	cout << "Exported " << db.size() << " games to " << file_name << '\n';
+}
+
+void find(const GameDatabase& db, int argc, char* argv[])
+{
+	if (!db.has_index())
+		throw(checkers_error("Database has no index (build it with index command)"));
+	if (argc < 1)
+		throw(checkers_error("Position is absent"));
+	game_rules rules = RULES_DEFAULT;
+	bool misere = false;
+	int shown_games = DEFAULT_SHOWN_GAMES, moves_begin = argc;
+	for (int i = 1; i < argc; ++i)
+		if (strcmp(argv[i], "-english") == 0)
+			rules = RULES_ENGLISH;
+		else if (strcmp(argv[i], "-misere") == 0)
+			misere = true;
+		else if (strcmp(argv[i], "-games") == 0 && i + 1 < argc)
+			shown_games = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-moves") == 0)
+		{
+			moves_begin = i + 1;
+			break;
+		}
+		else
+			throw(checkers_error(string("Unknown option ") + argv[i]));
+	Checkers board(rules, misere);
+	if (strchr(argv[0], ':') != nullptr)
+	{
+		if (!board.set_fen(argv[0], argv[0] + strlen(argv[0])))
+			throw(checkers_error(string("Position string ") + argv[0] + " is malformed"));
+	}
+	else if (strcmp(argv[0], "start") != 0)
+	{
+		ifstream in(argv[0]);
+		if (!in)
+			throw(checkers_error(string("Unable to open position file ") + argv[0]));
+		board.load_board(in);
+	}
+	for (int i = moves_begin; i < argc; ++i)
+	{
+		istringstream ss(argv[i]);
+		Move move;
+		if (!Board::read_move(ss, move) || !board.move(move))
+			throw(checkers_error(string("Move ") + argv[i] + " is illegal"));
+	}
+	const GameIndexEntry* first;
+	const size_t count = db.find(board.get_full_hash(), first);
+	cout << "Position occurs " << count << " times (" << db.get_indexed_count() << " games are indexed)\n";
+	vector<MoveStats> stats;
+	db.get_stats(board, stats);
+	for (const auto& cur : stats)
+		cout << move_str(cur.move) << ": " << cur.games << " games, +" << cur.wins << " =" << cur.draws
+			<< " -" << cur.losses << " (" << (cur.wins + cur.draws * 0.5) * 100 / cur.games << "%)\n";
+	for (size_t i = 0; i < count && i < size_t(shown_games); ++i)
+		cout << "Game " << first[i].game << ", ply " << first[i].ply << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		usage();
+		return 1;
+	}
+	const string command = argv[1], db_file = argv[2];
+	try
+	{
+		if (command == "import")
+		{
+			import(db_file, argc - 3, argv + 3);
+			return 0;
+		}
+		GameDatabase db;
+		db.open(db_file);
+		if (command == "export" && argc == 4)
+			export_games(db, argv[3]);
+		else if (command == "index")
+		{
+			const int max_ply = (argc == 5 && strcmp(argv[3], "-ply") == 0 ? atoi(argv[4]) : INT16_MAX);
+			const auto start_time = chrono::steady_clock::now();
+			db.build_index(max_ply);
+			cout << "Index of " << db.size() << " games is built in "
+				<< chrono::duration<double>(chrono::steady_clock::now() - start_time).count() << " s\n";
+		}
+		else if (command == "find")
+			find(db, argc - 3, argv + 3);
+		else if (command == "info")
+			cout << db.size() << " games, " << (db.has_index() ? to_string(db.get_indexed_count())
+				+ " of them are indexed" : string("no index")) << '\n';
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+// Checkers SPSA tuner
+// Tunes search parameters by simultaneous perturbation stochastic approximation over parallel self-play
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/search_params.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+constexpr int DEFAULT_ITERATIONS = 1000; // Default count of SPSA iterations
+constexpr int DEFAULT_PAIRS = 8; // Default count of game pairs (same opening, swapped colours) per iteration
+constexpr uint64_t DEFAULT_NODE_LIMIT = 20000; // Default node budget per move
+constexpr int DEFAULT_RANDOM_PLIES = 8; // Default count of random opening plies
+constexpr int MAX_GAME_PLY = 300; // Longer games are adjudicated as draws
+constexpr double SPSA_ALPHA = 0.602, SPSA_GAMMA = 0.101; // Standard decay exponents of SPSA gain sequences
+
+struct Settings
+{
+	game_rules rules = RULES_DEFAULT;
+	bool misere = false;
+	int iterations = DEFAULT_ITERATIONS;
+	int pairs = DEFAULT_PAIRS;
+	int threads = max<int>(thread::hardware_concurrency(), 1);
+	uint64_t node_limit = DEFAULT_NODE_LIMIT;
+	int random_plies = DEFAULT_RANDOM_PLIES;
+	double a = 2.0; // Step gain (in units of parameter steps per unit of result)
+	double c = 1.0; // Perturbation gain (in units of parameter steps)
+};
+
+// Engines of one thread (the first plays with positively perturbed parameters, the second with negatively perturbed)
+struct Players
+{
+	unique_ptr<Checkers> engine[2];
+};
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_SPSA <output parameters file> [options]\n"
+		"Options:\n"
+		"  -params <file>   initial parameters (default are engine's built-in ones)\n"
+		"  -iterations <n>  count of iterations (default " << DEFAULT_ITERATIONS << ")\n"
+		"  -pairs <n>       game pairs per iteration (default " << DEFAULT_PAIRS << ")\n"
+		"  -threads <n>     count of threads (default is count of cores)\n"
+		"  -nodes <n>       node budget per move (default " << DEFAULT_NODE_LIMIT << ")\n"
+		"  -random <n>      count of random opening plies (default " << DEFAULT_RANDOM_PLIES << ")\n"
+		"  -a <x>           step gain (default 2)\n"
+		"  -c <x>           perturbation gain (default 1)\n"
+		"  -english         play by english rules\n"
+		"  -misere          play misere games\n";
+}
+
+// Generates random opening (sequence of moves which doesn't end the game)
+vector<Move> random_opening(Checkers& engine, const Settings& settings, mt19937& gen)
+{
+	vector<Move> opening;
+	do
+	{
+		opening.clear();
+		engine.restart(settings.rules, settings.misere);
+		for (int ply = 0; ply < settings.random_plies && engine.get_state() == GAME_CONTINUE; ++ply)
+		{
+			const auto& moves = engine.get_part_possible_moves();
+			opening.push_back(moves[uniform_int_distribution<size_t>(0, moves.size() - 1)(gen)]);
+			Move move = opening.back();
+			engine.move(move);
+		}
+	} while (engine.get_state() != GAME_CONTINUE);
+	return opening;
+}
+
+// Plays a game from given opening where the first engine plays given colour. Returns its score (1 - win, 0.5 - draw, 0 - loss)
+double play_game(Players& players, const vector<Move>& opening, colour first_colour, const Settings& settings)
+{
+	for (auto& engine : players.engine)
+	{
+		engine->restart(settings.rules, settings.misere);
+		for (Move move : opening)
+			engine->move(move);
+	}
+	game_state state = GAME_CONTINUE;
+	while (state == GAME_CONTINUE && players.engine[0]->get_current_ply() < MAX_GAME_PLY)
+	{
+		Checkers& side = *players.engine[players.engine[0]->current_turn_colour() == first_colour ? 0 : 1];
+		Move move;
+		if (side.get_computer_move(move) == 0)
+		{
+			state = side.get_state(); // No moves (or budget didn't allow to finish even the first iteration)
+			break;
+		}
+		for (auto& engine : players.engine)
+		{
+			Move copy = move;
+			engine->move(copy);
+		}
+		state = players.engine[0]->get_state();
+	}
+	if (state == WHITE_WIN || state == BLACK_WIN)
+		return (state == WHITE_WIN) == (first_colour == WHITE) ? 1.0 : 0.0;
+	return 0.5;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		usage();
+		return 1;
+	}
+	Settings settings;
+	string params_file;
+	for (int i = 2; i < argc; ++i)
+	{
+		const bool has_value = (i + 1 < argc);
+		if (strcmp(argv[i], "-params") == 0 && has_value)
+			params_file = argv[++i];
+		else if (strcmp(argv[i], "-iterations") == 0 && has_value)
+			settings.iterations = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-pairs") == 0 && has_value)
+			settings.pairs = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-threads") == 0 && has_value)
+			settings.threads = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-nodes") == 0 && has_value)
+			settings.node_limit = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-random") == 0 && has_value)
+			settings.random_plies = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-a") == 0 && has_value)
+			settings.a = atof(argv[++i]);
+		else if (strcmp(argv[i], "-c") == 0 && has_value)
+			settings.c = atof(argv[++i]);
+		else if (strcmp(argv[i], "-english") == 0)
+			settings.rules = RULES_ENGLISH;
+		else if (strcmp(argv[i], "-misere") == 0)
+			settings.misere = true;
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	try
+	{
+		SearchParams params;
+		if (!params_file.empty())
+			params.load(params_file);
+		settings.threads = min(settings.threads, settings.pairs);
+		vector<Players> players(settings.threads);
+		for (auto& thread_players : players)
+			for (auto& engine : thread_players.engine)
+			{
+				engine = make_unique<Checkers>(settings.rules, settings.misere);
+				engine->set_search_depth(Checkers::UNBOUNDED_DEPTH);
+				engine->set_time_limit(1e9f); // Only node budget limits the search
+				engine->set_node_limit(settings.node_limit);
+			}
+		// Parameters are tuned in units of their steps
+		double theta[SEARCH_PARAM_COUNT];
+		for (int i = 0; i < SEARCH_PARAM_COUNT; ++i)
+			theta[i] = double(params.value[i]) / SEARCH_PARAM_INFO[i].step;
+		const double stability = settings.iterations / 10.0; // Stability constant of step gain sequence
+		random_device seeder;
+		mt19937 gen(seeder());
+		for (int iter = 0; iter < settings.iterations; ++iter)
+		{
+			const double a_k = settings.a / pow(iter + 1 + stability, SPSA_ALPHA);
+			const double c_k = settings.c / pow(iter + 1, SPSA_GAMMA);
+			// Perturb all parameters simultaneously in random directions
+			int delta[SEARCH_PARAM_COUNT];
+			SearchParams plus, minus;
+			for (int i = 0; i < SEARCH_PARAM_COUNT; ++i)
+			{
+				delta[i] = (gen() & 1) ? 1 : -1;
+				plus.set(search_param(i), int(lround((theta[i] + c_k * delta[i]) * SEARCH_PARAM_INFO[i].step)));
+				minus.set(search_param(i), int(lround((theta[i] - c_k * delta[i]) * SEARCH_PARAM_INFO[i].step)));
+			}
+			// Play game pairs between perturbed parameter sets
+			atomic<int> next_pair(0);
+			vector<double> thread_score(settings.threads, 0.0);
+			vector<thread> workers;
+			for (int t = 0; t < settings.threads; ++t)
+				workers.emplace_back([&, t](unsigned seed) {
+					mt19937 thread_gen(seed);
+					players[t].engine[0]->set_search_params(plus);
+					players[t].engine[1]->set_search_params(minus);
+					while (next_pair++ < settings.pairs)
+					{
+						const vector<Move> opening = random_opening(*players[t].engine[0], settings, thread_gen);
+						thread_score[t] += play_game(players[t], opening, WHITE, settings)
+							+ play_game(players[t], opening, BLACK, settings);
+					}
+				}, seeder());
+			for (auto& worker : workers)
+				worker.join();
+			// Result of plus parameters against minus ones in [-1; 1]
+			const double result = 2.0 * accumulate(thread_score.begin(), thread_score.end(), 0.0) / (2 * settings.pairs) - 1.0;
+			for (int i = 0; i < SEARCH_PARAM_COUNT; ++i)
+			{
+				const auto& info = SEARCH_PARAM_INFO[i];
+				theta[i] += a_k * result / (2.0 * c_k * delta[i]);
+				theta[i] = min(max(theta[i], double(info.min_value) / info.step), double(info.max_value) / info.step);
+				params.set(search_param(i), int(lround(theta[i] * info.step)));
+			}
+			params.save(argv[1]);
+			cout << "Iteration " << iter + 1 << ", result " << result << ':';
+			for (int i = 0; i < SEARCH_PARAM_COUNT; ++i)
+				cout << ' ' << params.value[i];
+			cout << endl;
+		}
+		cout << "Tuned parameters are written to " << argv[1] << ":\n";
+		params.save(cout);
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+// Checkers tuner
+// Tunes handcrafted evaluation parameters on labelled positions by gradient descent (Texel method)
+// Copyright (c) 2017 Yurko Prokopets (aka YurkoFlisk)
+// main.cpp, version 1.8
+
+#include "engine/checkers.h"
+#include "engine/training_data.h"
+#include "engine/eval_params.h"
+#include "engine/misc.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <cmath>
+#include <numeric>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+constexpr int DEFAULT_EPOCHS = 300; // Default count of gradient descent iterations
+constexpr double DEFAULT_LEARNING_RATE = 0.5; // Default step size (Adam), in units of parameter values
+constexpr double ADAM_BETA1 = 0.9, ADAM_BETA2 = 0.999, ADAM_EPSILON = 1e-8; // Adam optimizer coefficients
+constexpr double MAX_SCALE = 0.1; // Upper bound of searched sigmoid scale
+
+// Position resolved to the quiet leaf of quiescence search, which is used in tuning
+struct Sample
+{
+	uint32_t white, black, queens; // Pieces of the leaf position (bit masks as in TrainingRecord)
+	float result; // Game result for white (in [0; 1])
+	int16_t score; // Search score for white
+};
+
+// Pieces of sample's position in the form used by evaluation model
+struct Features
+{
+	int count[PT_COUNT]; // Count of each piece
+	int psq_count; // Count of piece-square terms
+	int psq_param[32]; // Parameter of each piece-square term
+	int psq_sign[32]; // Sign of each piece-square term
+};
+
+struct Settings
+{
+	game_rules rules = RULES_DEFAULT;
+	bool misere = false;
+	int epochs = DEFAULT_EPOCHS;
+	double learning_rate = DEFAULT_LEARNING_RATE;
+	double lambda = 1.0; // Weight of game result in target (the rest is given to search score)
+	int resolve_interval = 0; // Count of epochs between resolving samples with current parameters (0 - only once)
+	int threads = max<int>(thread::hardware_concurrency(), 1);
+};
+
+// Board that resolves training positions to quiet leaves of quiescence search
+class TunerBoard
+	: public Checkers
+{
+public:
+	TunerBoard(game_rules rule, bool mis)
+		: Checkers(rule, mis)
+	{}
+	// Returns the leaf of quiescence search from given record's position whose static score is the search result
+	TrainingRecord resolve(const TrainingRecord& record)
+	{
+		_clear_board();
+		for (int sq = 0; sq < 32; ++sq)
+			if (record.piece(sq).get_type() != PT_EMPTY)
+				_put_piece(TrainingRecord::square_position(sq), record.piece(sq));
+		TrainingRecord leaf;
+		if (record.turn() == WHITE)
+			_leaf_search<WHITE>(-MAX_SCORE, MAX_SCORE, leaf);
+		else
+			_leaf_search<BLACK>(-MAX_SCORE, MAX_SCORE, leaf);
+		return leaf;
+	}
+private:
+	// Quiescence search like in evaluate, but without pruning and with tracking of the principal leaf
+	template<colour TURN>
+	int16_t _leaf_search(int16_t alpha, int16_t beta, TrainingRecord& leaf)
+	{
+		int16_t best = static_score<TURN>();
+		leaf.set(*this, TURN, 0, 0);
+		if (best >= beta)
+			return best;
+		alpha = max(alpha, best);
+		if (!has_capture<TURN>())
+			return best;
+		MoveList moves;
+		get_all_moves<TURN, CAPTURE>(moves);
+		remove_equivalent_captures(moves);
+		TrainingRecord child_leaf;
+		for (int i = 0; i < moves.size(); ++i)
+		{
+			_do_move(moves[i].move);
+			const int16_t child_score = -_leaf_search<opposite(TURN)>(-beta, -alpha, child_leaf);
+			_undo_move(moves[i].move);
+			if (child_score > best)
+			{
+				best = child_score;
+				leaf = child_leaf;
+				alpha = max(alpha, best);
+				if (alpha >= beta)
+					break;
+			}
+		}
+		return best;
+	}
+};
+
+// Runs given function on [begin; end) subranges of [0; count) in given count of threads
+void parallel_for(int threads, size_t count, const function<void(int, size_t, size_t)>& func)
+{
+	vector<thread> workers;
+	for (int i = 0; i < threads; ++i)
+		workers.emplace_back(func, i, count * i / threads, count * (i + 1) / threads);
+	for (auto& worker : workers)
+		worker.join();
+}
+
+Features get_features(const Sample& sample)
+{
+	Features ftr = {};
+	for (int sq = 0; sq < 32; ++sq)
+	{
+		const uint32_t bit = uint32_t(1) << sq;
+		if (!((sample.white | sample.black) & bit))
+			continue;
+		const piece_type pt = Piece((sample.white & bit) ? WHITE : BLACK, (sample.queens & bit) != 0).get_type();
+		++ftr.count[pt];
+		ftr.psq_param[ftr.psq_count] = EvalParams::psq_param(pt, TrainingRecord::square_position(sq), ftr.psq_sign[ftr.psq_count]);
+		++ftr.psq_count;
+	}
+	return ftr;
+}
+
+// Evaluation model, which mirrors Checkers::score (for white as maximizer) with real-valued parameters.
+// If gradient is given, derivatives of the score by parameters multiplied by given factor are added to it
+double model_score(const double* param, const Features& ftr, bool misere, double* gradient = nullptr, double factor = 0.0)
+{
+	const bool endgame = (accumulate(ftr.count, ftr.count + PT_COUNT, 0) < 10);
+	const int nw_idx = (endgame ? EP_NORMAL_WEIGHT_ENDGAME : EP_NORMAL_WEIGHT);
+	const int qw_idx = (endgame ? EP_QUEEN_WEIGHT_ENDGAME : EP_QUEEN_WEIGHT);
+	const int ws = ftr.count[WHITE_SIMPLE], wq = ftr.count[WHITE_QUEEN], bs = ftr.count[BLACK_SIMPLE], bq = ftr.count[BLACK_QUEEN];
+	const double w = param[nw_idx] * ws + param[qw_idx] * wq, b = param[nw_idx] * bs + param[qw_idx] * bq;
+	const double sum = (w + b > 0 ? w + b : 1.0);
+	double sc = w - b + param[EP_RELMAT_MULT] * (w - b) / sum;
+	for (int i = 0; i < ftr.psq_count; ++i)
+		sc += ftr.psq_sign[i] * param[ftr.psq_param[i]];
+	if (gradient != nullptr)
+	{
+		if (misere)
+			factor = -factor;
+		// Derivative of relative material advantage (w - b) / (w + b) by w is 2b / (w + b)^2 and by b is -2w / (w + b)^2
+		const double rel = 2.0 * param[EP_RELMAT_MULT] / (sum * sum);
+		gradient[nw_idx] += factor * ((ws - bs) + rel * (b * ws - w * bs));
+		gradient[qw_idx] += factor * ((wq - bq) + rel * (b * wq - w * bq));
+		gradient[EP_RELMAT_MULT] += factor * (w - b) / sum;
+		for (int i = 0; i < ftr.psq_count; ++i)
+			gradient[ftr.psq_param[i]] += factor * ftr.psq_sign[i];
+	}
+	return misere ? -sc : sc;
+}
+
+inline double sigmoid(double scale, double score)
+{
+	return 1.0 / (1.0 + exp(-scale * score));
+}
+
+// Mean squared error of predictions with given parameters and sigmoid scale. If gradient is given, it is set to the error's gradient
+double error(const vector<Sample>& samples, const Settings& settings, const double* param, double scale, double lambda, double* gradient = nullptr)
+{
+	vector<double> thread_error(settings.threads, 0.0);
+	vector<vector<double>> thread_gradient(settings.threads, vector<double>(EVAL_PARAM_COUNT, 0.0));
+	parallel_for(settings.threads, samples.size(), [&](int thread_idx, size_t begin, size_t end) {
+		double err = 0.0;
+		double* grad = (gradient != nullptr ? thread_gradient[thread_idx].data() : nullptr);
+		for (size_t i = begin; i < end; ++i)
+		{
+			const Sample& sample = samples[i];
+			const Features ftr = get_features(sample);
+			const double prediction = sigmoid(scale, model_score(param, ftr, settings.misere));
+			const double target = lambda * sample.result + (1.0 - lambda) * sigmoid(scale, sample.score);
+			err += (prediction - target) * (prediction - target);
+			if (grad != nullptr)
+				model_score(param, ftr, settings.misere, grad,
+					2.0 * (prediction - target) * prediction * (1.0 - prediction) * scale);
+		}
+		thread_error[thread_idx] = err;
+	});
+	if (gradient != nullptr)
+		for (int p = 0; p < EVAL_PARAM_COUNT; ++p)
+		{
+			gradient[p] = 0.0;
+			for (const auto& grad : thread_gradient)
+				gradient[p] += grad[p];
+			gradient[p] /= samples.size();
+		}
+	return accumulate(thread_error.begin(), thread_error.end(), 0.0) / samples.size();
+}
+
+// Fits sigmoid scale to game results with given parameters (ternary search, since error is unimodal in it)
+double fit_scale(const vector<Sample>& samples, const Settings& settings, const double* param)
+{
+	double low = 0.0, high = MAX_SCALE;
+	for (int iter = 0; iter < 40; ++iter)
+	{
+		const double m1 = low + (high - low) / 3, m2 = high - (high - low) / 3;
+		if (error(samples, settings, param, m1, 1.0) < error(samples, settings, param, m2, 1.0))
+			high = m2;
+		else
+			low = m1;
+	}
+	return (low + high) / 2;
+}
+
+// Resolves records to quiet leaves with given parameters
+void resolve(const vector<TrainingRecord>& records, vector<Sample>& samples,
+	vector<unique_ptr<TunerBoard>>& boards, const Settings& settings, const EvalParams& params)
+{
+	samples.resize(records.size());
+	parallel_for(settings.threads, records.size(), [&](int thread_idx, size_t begin, size_t end) {
+		TunerBoard& board = *boards[thread_idx];
+		board.set_eval_params(params);
+		for (size_t i = begin; i < end; ++i)
+		{
+			const TrainingRecord& record = records[i];
+			const TrainingRecord leaf = board.resolve(record);
+			const int sign = (record.turn() == WHITE ? 1 : -1);
+			samples[i] = { leaf.white, leaf.black, leaf.queens,
+				(sign * record.result + 1) / 2.0f, int16_t(sign * record.score) };
+		}
+	});
+}
+
+void usage(void)
+{
+	cout << "Usage: Chkrs_Tuner <training data file> <output parameters file> [options]\n"
+		"Options:\n"
+		"  -params <file>   initial parameters (default are engine's built-in ones)\n"
+		"  -epochs <n>      count of gradient descent iterations (default " << DEFAULT_EPOCHS << ")\n"
+		"  -rate <x>        learning rate (default " << DEFAULT_LEARNING_RATE << ")\n"
+		"  -lambda <x>      weight of game result in target, the rest is given to search score (default 1)\n"
+		"  -resolve <n>     resolve quiescence leaves with current parameters every n epochs (default only once)\n"
+		"  -threads <n>     count of threads (default is count of cores)\n"
+		"  -english         tune for english rules\n"
+		"  -misere          tune for misere games\n";
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		usage();
+		return 1;
+	}
+	Settings settings;
+	string params_file;
+	for (int i = 3; i < argc; ++i)
+	{
+		const bool has_value = (i + 1 < argc);
+		if (strcmp(argv[i], "-params") == 0 && has_value)
+			params_file = argv[++i];
+		else if (strcmp(argv[i], "-epochs") == 0 && has_value)
+			settings.epochs = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-rate") == 0 && has_value)
+			settings.learning_rate = atof(argv[++i]);
+		else if (strcmp(argv[i], "-lambda") == 0 && has_value)
+			settings.lambda = atof(argv[++i]);
+		else if (strcmp(argv[i], "-resolve") == 0 && has_value)
+			settings.resolve_interval = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-threads") == 0 && has_value)
+			settings.threads = max(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "-english") == 0)
+			settings.rules = RULES_ENGLISH;
+		else if (strcmp(argv[i], "-misere") == 0)
+			settings.misere = true;
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	try
+	{
+		EvalParams params;
+		if (!params_file.empty())
+			params.load(params_file);
+		// Load records of chosen rules
+		vector<TrainingRecord> records;
+		{
+			TrainingDataReader reader(argv[1]);
+			TrainingRecord record;
+			while (reader.next(record))
+				if (record.rules() == settings.rules && record.misere() == settings.misere)
+					records.push_back(record);
+		}
+		if (records.empty())
+			throw(checkers_error("There are no positions of chosen rules in training data"));
+		cout << "Loaded " << records.size() << " positions" << endl;
+		vector<unique_ptr<TunerBoard>> boards;
+		for (int i = 0; i < settings.threads; ++i)
+			boards.push_back(make_unique<TunerBoard>(settings.rules, settings.misere));
+		vector<Sample> samples;
+		resolve(records, samples, boards, settings, params);
+		// Tune
+		double param[EVAL_PARAM_COUNT], gradient[EVAL_PARAM_COUNT], moment[EVAL_PARAM_COUNT] = {}, velocity[EVAL_PARAM_COUNT] = {};
+		copy(params.value, params.value + EVAL_PARAM_COUNT, param);
+		const double scale = fit_scale(samples, settings, param);
+		cout << "Sigmoid scale: " << scale << ", initial error: " << error(samples, settings, param, scale, settings.lambda) << endl;
+		for (int epoch = 1; epoch <= settings.epochs; ++epoch)
+		{
+			const double err = error(samples, settings, param, scale, settings.lambda, gradient);
+			for (int p = 0; p < EVAL_PARAM_COUNT; ++p)
+			{
+				moment[p] = ADAM_BETA1 * moment[p] + (1 - ADAM_BETA1) * gradient[p];
+				velocity[p] = ADAM_BETA2 * velocity[p] + (1 - ADAM_BETA2) * gradient[p] * gradient[p];
+				const double moment_hat = moment[p] / (1 - pow(ADAM_BETA1, epoch));
+				const double velocity_hat = velocity[p] / (1 - pow(ADAM_BETA2, epoch));
+				param[p] -= settings.learning_rate * moment_hat / (sqrt(velocity_hat) + ADAM_EPSILON);
+			}
+			for (int p = 0; p < EVAL_PARAM_COUNT; ++p)
+				params.value[p] = int16_t(lround(param[p]));
+			params.expand();
+			params.save(argv[2]);
+			cout << "Epoch " << epoch << ", error: " << setprecision(8) << err << endl;
+			if (settings.resolve_interval > 0 && epoch % settings.resolve_interval == 0)
+				resolve(records, samples, boards, settings, params);
+		}
+		cout << "Tuned parameters are written to " << argv[2] << ":\n";
+		params.save(cout);
+	}
+	catch (const checkers_error& err)
+	{
+		cout << err.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
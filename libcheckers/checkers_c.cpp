@@ -0,0 +1,379 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// checkers_c.cpp, version 1.8
+
+#include "checkers_c.h"
+#include "engine/checkers.h"
+#include "engine/async_search.h"
+#include "engine/misc.h"
+#include <sstream>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+struct checkers_engine
+{
+	checkers_engine(game_rules rules, bool misere)
+		: engine(new Checkers(rules, misere)), search(*engine), result()
+	{}
+	// Resources are declared first, so that they outlive the engine which uses them
+	std::unique_ptr<Bitbase> bitbase;
+	std::unique_ptr<NNUE> network;
+	std::unique_ptr<Checkers> engine;
+	AsyncSearch search;
+	std::mutex mutex; // Serializes calls which use the engine (they fail while asynchronous search runs)
+	std::mutex result_mutex; // Guards result, which is set from the search thread
+	checkers_search_result result; // Result of the last search
+	std::string error;
+};
+
+namespace
+{
+	constexpr float UNLIMITED_TIME = 1e9f;
+
+	std::string move_string(const Move& move)
+	{
+		std::ostringstream ss;
+		Board::write_move(ss, move);
+		return ss.str();
+	}
+
+	size_t copy_string(const std::string& str, char* buffer, size_t size)
+	{
+		if (buffer != nullptr && size != 0)
+		{
+			const size_t count = std::min(str.size(), size - 1);
+			std::memcpy(buffer, str.data(), count);
+			buffer[count] = '\0';
+		}
+		return str.size();
+	}
+
+	checkers_search_result make_result(const Checkers& engine, const SearchResult& search_result)
+	{
+		checkers_search_result result = {};
+		if (search_result.move.size() != 0)
+			copy_string(move_string(search_result.move), result.move, sizeof(result.move));
+		result.score = search_result.score;
+		result.depth = search_result.depth;
+		result.nodes = engine.get_nodes();
+		return result;
+	}
+
+	// Calls given function with the engine of given handle, translating exceptions to error status
+	template<typename Function>
+	checkers_status guarded(checkers_engine* handle, Function&& function)
+	{
+		if (handle == nullptr)
+			return CHECKERS_ERROR;
+		std::lock_guard<std::mutex> lock(handle->mutex);
+		if (handle->search.is_running())
+		{
+			handle->error = "Search is running";
+			return CHECKERS_BUSY;
+		}
+		try
+		{
+			return function(*handle->engine);
+		}
+		catch (const checkers_error& err)
+		{
+			handle->error = err.what();
+		}
+		catch (const std::exception& err)
+		{
+			handle->error = err.what();
+		}
+		return CHECKERS_ERROR;
+	}
+
+	inline game_rules to_rules(checkers_rules rules)
+	{
+		return rules == CHECKERS_RULES_ENGLISH ? RULES_ENGLISH : RULES_DEFAULT;
+	}
+}
+
+int checkers_api_version(void)
+{
+	return CHECKERS_API_VERSION;
+}
+
+checkers_engine* checkers_create(checkers_rules rules, int misere)
+{
+	try
+	{
+		return new checkers_engine(to_rules(rules), misere != 0);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void checkers_destroy(checkers_engine* handle)
+{
+	delete handle;
+}
+
+const char* checkers_last_error(const checkers_engine* handle)
+{
+	return handle == nullptr ? "Engine handle is null" : handle->error.c_str();
+}
+
+checkers_status checkers_set_limits(checkers_engine* handle, int depth, double time, unsigned long long nodes)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		engine.set_search_depth(depth <= 0 ? Checkers::UNBOUNDED_DEPTH
+			: int8_t(std::min(depth, int(Checkers::MAX_SEARCH_DEPTH))));
+		engine.set_time_limit(time <= 0 ? UNLIMITED_TIME : float(time));
+		engine.set_node_limit(nodes);
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_set_hash_size(checkers_engine* handle, size_t size)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		engine.set_hash_size(std::max<size_t>(size, 1));
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_load_bitbase(checkers_engine* handle, const char* file_name)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		std::unique_ptr<Bitbase> bitbase(new Bitbase);
+		bitbase->load(file_name);
+		engine.set_bitbase(bitbase.get());
+		handle->bitbase.swap(bitbase);
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_load_network(checkers_engine* handle, const char* file_name)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		std::unique_ptr<NNUE> network(new NNUE);
+		network->load(file_name);
+		engine.set_network(network.get());
+		handle->network.swap(network);
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_load_eval_params(checkers_engine* handle, const char* file_name)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		EvalParams params;
+		params.load(file_name);
+		engine.set_eval_params(params);
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_load_search_params(checkers_engine* handle, const char* file_name)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		SearchParams params;
+		params.load(file_name);
+		engine.set_search_params(params);
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_new_game(checkers_engine* handle, checkers_rules rules, int misere)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		engine.restart(to_rules(rules), misere != 0);
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_set_board(checkers_engine* handle, const char* board)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		std::istringstream ss(board);
+		engine.load_board(ss);
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_set_game(checkers_engine* handle, const char* game)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		std::istringstream ss(game);
+		engine.load_game(ss);
+		return CHECKERS_OK;
+	});
+}
+
+size_t checkers_get_board(checkers_engine* handle, char* buffer, size_t size)
+{
+	std::string board;
+	guarded(handle, [&](Checkers& engine) {
+		std::ostringstream ss;
+		engine.save_board(ss);
+		board = ss.str();
+		return CHECKERS_OK;
+	});
+	return copy_string(board, buffer, size);
+}
+
+size_t checkers_get_fen(checkers_engine* handle, char* buffer, size_t size)
+{
+	char fen[Board::FEN_BUFFER_SIZE] = "";
+	guarded(handle, [&](Checkers& engine) {
+		engine.get_fen(fen);
+		return CHECKERS_OK;
+	});
+	return copy_string(fen, buffer, size);
+}
+
+checkers_status checkers_play_move(checkers_engine* handle, const char* move_str)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		std::istringstream ss(move_str);
+		Move move;
+		if (!Board::read_move(ss, move) || !engine.move(move))
+		{
+			handle->error = std::string("Illegal move ") + move_str;
+			return CHECKERS_ILLEGAL_MOVE;
+		}
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_undo_move(checkers_engine* handle)
+{
+	return guarded(handle, [](Checkers& engine) {
+		engine.undo_move();
+		return CHECKERS_OK;
+	});
+}
+
+int checkers_white_to_move(checkers_engine* handle)
+{
+	int white = 0;
+	guarded(handle, [&](Checkers& engine) {
+		white = (engine.current_turn_colour() == WHITE);
+		return CHECKERS_OK;
+	});
+	return white;
+}
+
+checkers_game_state checkers_get_state(checkers_engine* handle)
+{
+	checkers_game_state state = CHECKERS_GAME_CONTINUE;
+	guarded(handle, [&](Checkers& engine) {
+		state = static_cast<checkers_game_state>(engine.get_state());
+		return CHECKERS_OK;
+	});
+	return state;
+}
+
+size_t checkers_get_moves(checkers_engine* handle, char* buffer, size_t size)
+{
+	std::string moves;
+	guarded(handle, [&](Checkers& engine) {
+		std::vector<Move> legal;
+		engine.get_all_moves(legal);
+		for (const Move& move : legal)
+			moves += (moves.empty() ? "" : " ") + move_string(move);
+		return CHECKERS_OK;
+	});
+	return copy_string(moves, buffer, size);
+}
+
+size_t checkers_get_pv(checkers_engine* handle, int max_length, char* buffer, size_t size)
+{
+	std::string pv_str;
+	guarded(handle, [&](Checkers& engine) {
+		std::vector<Move> pv;
+		engine.get_pv(pv, max_length);
+		for (const Move& move : pv)
+			pv_str += (pv_str.empty() ? "" : " ") + move_string(move);
+		return CHECKERS_OK;
+	});
+	return copy_string(pv_str, buffer, size);
+}
+
+checkers_status checkers_search(checkers_engine* handle, checkers_search_result* result)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		if (engine.get_state() != GAME_CONTINUE)
+			return CHECKERS_NO_MOVES;
+		SearchResult search_result;
+		engine.reset_stop();
+		search_result.depth = engine.get_computer_move(search_result.move, search_result.score);
+		const checkers_search_result res = make_result(engine, search_result);
+		{
+			std::lock_guard<std::mutex> lock(handle->result_mutex);
+			handle->result = res;
+		}
+		if (result != nullptr)
+			*result = res;
+		return CHECKERS_OK;
+	});
+}
+
+checkers_status checkers_search_async(checkers_engine* handle, checkers_search_callback callback, void* user_data)
+{
+	return guarded(handle, [=](Checkers& engine) {
+		if (engine.get_state() != GAME_CONTINUE)
+			return CHECKERS_NO_MOVES;
+		handle->search.start([handle, callback, user_data](const SearchResult& search_result) {
+			const checkers_search_result res = make_result(*handle->engine, search_result);
+			{
+				std::lock_guard<std::mutex> lock(handle->result_mutex);
+				handle->result = res;
+			}
+			if (callback != nullptr)
+				callback(user_data, &res);
+		});
+		return CHECKERS_OK;
+	});
+}
+
+void checkers_stop(checkers_engine* handle)
+{
+	if (handle != nullptr)
+		handle->search.stop();
+}
+
+checkers_status checkers_wait(checkers_engine* handle, checkers_search_result* result)
+{
+	if (handle == nullptr)
+		return CHECKERS_ERROR;
+	std::lock_guard<std::mutex> lock(handle->mutex);
+	handle->search.wait();
+	if (result != nullptr)
+	{
+		std::lock_guard<std::mutex> result_lock(handle->result_mutex);
+		*result = handle->result;
+	}
+	return CHECKERS_OK;
+}
+
+int checkers_is_searching(const checkers_engine* handle)
+{
+	return handle != nullptr && handle->search.is_running();
+}
\ No newline at end of file
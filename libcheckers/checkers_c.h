@@ -0,0 +1,128 @@
+/*
+========================================================================
+Copyright (c) 2017 Yurko Prokopets(aka YurkoFlisk)
+
+This file is part of Checkers source code
+
+Checkers is free software : you can redistribute it and / or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Checkers is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Checkers.If not, see <http://www.gnu.org/licenses/>
+========================================================================
+*/
+
+// checkers_c.h, version 1.8
+
+// C interface of the engine for embedding it into other programs. Every engine handle is independent
+// (owns its board, transposition tables and loaded resources) and its functions can be called from any thread.
+// Strings are written snprintf-like: returned value is the full length of the string (without terminating
+// zero), and at most given size of bytes (including terminating zero) is written to the buffer
+
+#pragma once
+#ifndef _CHECKERS_C_H
+#define _CHECKERS_C_H
+#include <stddef.h>
+
+#if defined _WIN32 && !defined CHECKERS_STATIC
+#ifdef CHECKERS_EXPORTS
+#define CHECKERS_API __declspec(dllexport)
+#else
+#define CHECKERS_API __declspec(dllimport)
+#endif
+#elif defined __GNUC__
+#define CHECKERS_API __attribute__((visibility("default")))
+#else
+#define CHECKERS_API
+#endif
+
+#define CHECKERS_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct checkers_engine checkers_engine;
+
+typedef enum checkers_status
+{
+	CHECKERS_OK = 0,
+	CHECKERS_ERROR, // Function failed, checkers_last_error describes the reason
+	CHECKERS_ILLEGAL_MOVE,
+	CHECKERS_BUSY, // Asynchronous search is running, so the engine can't be changed
+	CHECKERS_NO_MOVES // Game has ended, there is nothing to search
+} checkers_status;
+
+typedef enum checkers_rules
+{
+	CHECKERS_RULES_DEFAULT = 0,
+	CHECKERS_RULES_ENGLISH
+} checkers_rules;
+
+typedef enum checkers_game_state
+{
+	CHECKERS_GAME_CONTINUE = 0,
+	CHECKERS_DRAW,
+	CHECKERS_WHITE_WIN,
+	CHECKERS_BLACK_WIN
+} checkers_game_state;
+
+typedef struct checkers_search_result
+{
+	char move[64]; // Best move in text notation (empty if the game has ended)
+	int score; // Score for side to move
+	int depth; // Depth of the last finished iteration
+	unsigned long long nodes;
+} checkers_search_result;
+
+// Receives the result of asynchronous search in the search thread. It may only call checkers_stop,
+// checkers_is_searching and checkers_last_error for the same handle
+typedef void(*checkers_search_callback)(void*, const checkers_search_result*);
+
+CHECKERS_API int checkers_api_version(void);
+
+// Handles
+CHECKERS_API checkers_engine* checkers_create(checkers_rules, int); // Rules and misere flag. Returns NULL on failure
+CHECKERS_API void checkers_destroy(checkers_engine*); // Stops and waits for the search
+CHECKERS_API const char* checkers_last_error(const checkers_engine*); // Valid until the next failure
+
+// Configuration. Limits which are zero or negative are unbounded
+CHECKERS_API checkers_status checkers_set_limits(checkers_engine*, int, double, unsigned long long); // Depth, time (ms), nodes
+CHECKERS_API checkers_status checkers_set_hash_size(checkers_engine*, size_t); // Megabytes (tables are cleared)
+CHECKERS_API checkers_status checkers_load_bitbase(checkers_engine*, const char*);
+CHECKERS_API checkers_status checkers_load_network(checkers_engine*, const char*);
+CHECKERS_API checkers_status checkers_load_eval_params(checkers_engine*, const char*);
+CHECKERS_API checkers_status checkers_load_search_params(checkers_engine*, const char*);
+
+// Position
+CHECKERS_API checkers_status checkers_new_game(checkers_engine*, checkers_rules, int);
+CHECKERS_API checkers_status checkers_set_board(checkers_engine*, const char*); // Board in format of Checkers::load_board
+CHECKERS_API checkers_status checkers_set_game(checkers_engine*, const char*); // Game in format of Checkers::load_game
+CHECKERS_API size_t checkers_get_board(checkers_engine*, char*, size_t); // Board in format of Checkers::save_board
+CHECKERS_API size_t checkers_get_fen(checkers_engine*, char*, size_t); // Position string of Board::get_fen
+CHECKERS_API checkers_status checkers_play_move(checkers_engine*, const char*);
+CHECKERS_API checkers_status checkers_undo_move(checkers_engine*);
+CHECKERS_API int checkers_white_to_move(checkers_engine*);
+CHECKERS_API checkers_game_state checkers_get_state(checkers_engine*);
+CHECKERS_API size_t checkers_get_moves(checkers_engine*, char*, size_t); // Space-separated legal moves
+CHECKERS_API size_t checkers_get_pv(checkers_engine*, int, char*, size_t); // Principal variation of at most given length
+
+// Search
+CHECKERS_API checkers_status checkers_search(checkers_engine*, checkers_search_result*); // Synchronous search
+CHECKERS_API checkers_status checkers_search_async(checkers_engine*, checkers_search_callback, void*);
+CHECKERS_API void checkers_stop(checkers_engine*); // Requests stop of the search (its result is still reported)
+CHECKERS_API checkers_status checkers_wait(checkers_engine*, checkers_search_result*); // Waits for asynchronous search
+CHECKERS_API int checkers_is_searching(const checkers_engine*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file